@@ -0,0 +1,982 @@
+/*++
+
+Copyright (c) 2014 Microsoft Corporation, All Rights Reserved
+
+Module Name:
+    triage.cpp
+
+Abstract:
+    Builds and submits the triage package, see triage.h.
+
+Environment:
+    User Mode
+
+--*/
+
+#include "buildparams.h"
+#include "triage.h"
+#include "Memory_Budget.h"
+#include "logging.h"
+#include <werapi.h>
+#include <Pathcch.h>
+
+//
+// Page table entry bits used by the page walks below. They follow the
+// decoding done by raw2dump's VirtualToPhysical and VirtualToPhysical64, and
+// also check the Valid bit of every entry and the full 8 bytes of PAE ones.
+//
+#define TRIAGE_PAGE_MASK                    (~((UINT64)PAGE_SIZE - 1))
+#define TRIAGE_PFN_MASK32                   0xFFFFF000
+#define TRIAGE_PAE_PDPT_MASK                0xFFFFFFE0
+#define TRIAGE_PDE_MASK32                   0xFFC00000
+#define TRIAGE_LARGE_PAGE_OFFSET_MASK32     0x003FFFFF
+
+#if defined(_ARM_)
+#define TRIAGE_PTE_VALID32                  0x2         // HARDWARE_PTE.Valid
+#define TRIAGE_PDE_LARGE_PAGE32             0x400       // HARDWARE_PTE.LargePage
+#elif defined(_X86_)
+#define TRIAGE_PTE_VALID32                  0x1         // HARDWARE_PTE.Valid
+#define TRIAGE_PDE_LARGE_PAGE32             0x80        // HARDWARE_PTE.LargePage
+#else
+#define TRIAGE_PTE_VALID32                  0x1
+#define TRIAGE_PDE_LARGE_PAGE32             0
+#endif
+
+#define TRIAGE_PAE_VALID                    0x1         // HARDWARE_PTE_X86PAE.Valid
+#define TRIAGE_PAE_LARGE_PAGE               0x80        // HARDWARE_PTE_X86PAE.LargePage, in a PDE
+#define TRIAGE_PAE_PFN_MASK                 0x000FFFFFFFFFF000UI64
+#define TRIAGE_PAE_2MB_PAGE_MASK            0x000FFFFFFFE00000UI64
+#define TRIAGE_PAE_2MB_OFFSET_MASK          0x00000000001FFFFFUI64
+
+#define TRIAGE_ARM64_VALID                  0x1
+#define TRIAGE_ARM64_NOT_LARGE_PAGE         0x2
+#define TRIAGE_ARM64_PFN_MASK               0x0000FFFFFFFFF000UI64
+#define TRIAGE_ARM64_1GB_PAGE_MASK          0x0000FFFFC0000000UI64
+#define TRIAGE_ARM64_1GB_OFFSET_MASK        0x000000003FFFFFFFUI64
+#define TRIAGE_ARM64_2MB_PAGE_MASK          0x0000FFFFFFE00000UI64
+#define TRIAGE_ARM64_2MB_OFFSET_MASK        0x00000000001FFFFFUI64
+#define TRIAGE_ARM64_USED_VA_BITS           48
+#define TRIAGE_ARM64_UNUSED_VA_MASK         0xFFFF
+#define TRIAGE_ARM64_TABLE_INDEX_MASK       0x1FF
+
+//
+// Pages collected for the package, in the order they were found.
+//
+typedef struct _TRIAGE_CONTEXT
+{
+    UINT64                                              DirectoryTableBase;
+    BOOLEAN                                             PaeEnabled;
+    UINT32                                              PageCount;
+    UINT32                                              DroppedPageCount;
+    UINT64                                              Pages[TRIAGE_MAX_PAGES];
+} TRIAGE_CONTEXT, *PTRIAGE_CONTEXT;
+
+
+bool
+ShouldSubmitTriageDump(
+    void
+)
+/*++
+
+Routine Description:
+    The triage package is sent unless
+    HKLM\System\CurrentControlSet\Control\CrashControl\TriageDumpEnabled is
+    present and set to zero.
+
+Return Value:
+    true if the triage package should be built and submitted.
+
+--*/
+{
+    HKEY    hKey;
+    DWORD   rc;
+    DWORD   val;
+    DWORD   vallen;
+    bool    ret = true;
+
+    rc = RegOpenKeyExW(HKEY_LOCAL_MACHINE, CRASHCONTROL_PATH, 0, KEY_READ, &hKey);
+    if (rc == ERROR_SUCCESS) {
+        vallen = sizeof(val);
+        val = 1;
+        rc = RegQueryValueExW(hKey, CRASHCONTROL_TRIAGE_ENABLED, nullptr, nullptr, (LPBYTE)&val, (LPDWORD)&vallen);
+        if ((rc == ERROR_SUCCESS) && (val == 0)) {
+            ret = false;
+        }
+
+        RegCloseKey(hKey);
+    }
+
+    return ret;
+}
+
+
+static
+BOOLEAN
+TriageIsPageInDDRMap(
+    _In_ PDMP_CONTEXT Context,
+    _In_ UINT64 Page
+)
+{
+    UINT32  index;
+
+    for (index = 0; index < Context->DDRMemoryMapCount; index++) {
+        if ((Context->DDRMemoryMap[index].Base <= Page) &&
+            (Context->DDRMemoryMap[index].End >= Page + PAGE_SIZE - 1)) {
+            return TRUE;
+        }
+    }
+
+    return FALSE;
+}
+
+
+static
+VOID
+TriageAddPhysicalRange(
+    _In_    PDMP_CONTEXT Context,
+    _Inout_ PTRIAGE_CONTEXT Triage,
+    _In_    UINT64 PhysicalAddress,
+    _In_    UINT64 Length
+)
+/*++
+
+Routine Description:
+    Adds every page touched by [PhysicalAddress, PhysicalAddress + Length) to
+    the package. Pages outside the DDR sections are ignored, pages beyond
+    TRIAGE_MAX_PAGES are counted and dropped.
+
+--*/
+{
+    UINT64  page;
+    UINT64  end;
+    UINT32  index;
+
+    if (Length == 0) {
+        return;
+    }
+
+    end = PhysicalAddress + Length;
+    for (page = PhysicalAddress & TRIAGE_PAGE_MASK; page < end; page += PAGE_SIZE) {
+        if (!TriageIsPageInDDRMap(Context, page)) {
+            continue;
+        }
+
+        for (index = 0; index < Triage->PageCount; index++) {
+            if (Triage->Pages[index] == page) {
+                break;
+            }
+        }
+
+        if (index < Triage->PageCount) {
+            continue;
+        }
+
+        if (Triage->PageCount == TRIAGE_MAX_PAGES) {
+            Triage->DroppedPageCount++;
+            continue;
+        }
+
+        Triage->Pages[Triage->PageCount] = page;
+        Triage->PageCount++;
+    }
+}
+
+
+static
+HRESULT
+TriageReadPhysical(
+    _In_    PDMP_CONTEXT Context,
+    _Inout_ PTRIAGE_CONTEXT Triage,
+    _In_    UINT64 PhysicalAddress,
+    _In_    UINT32 Length,
+    _Out_writes_bytes_(Length) PVOID Buffer
+)
+{
+    LARGE_INTEGER   address;
+    HRESULT         result;
+
+    address.QuadPart = PhysicalAddress;
+    result = ReadFromDDRSectionByPhysicalAddress(Context, address, Length, Buffer);
+    if (SUCCEEDED(result)) {
+        TriageAddPhysicalRange(Context, Triage, PhysicalAddress, Length);
+    }
+
+    return result;
+}
+
+
+static
+HRESULT
+TriageVirtualToPhysical(
+    _In_    PDMP_CONTEXT Context,
+    _Inout_ PTRIAGE_CONTEXT Triage,
+    _In_    UINT64 VirtualAddress,
+    _Out_   PUINT64 PhysicalAddress
+)
+/*++
+
+Routine Description:
+    Translates a kernel virtual address using the page tables in the raw
+    dump. Every page table page read on the way is added to the package so
+    that the debugger can repeat the translation on the triage package.
+
+Arguments:
+    Context - DMP_CONTEXT
+    Triage - Triage package being built.
+    VirtualAddress - Address to translate.
+    PhysicalAddress - Receives the physical address.
+
+Return Value:
+    HRESULT
+
+--*/
+{
+    HRESULT     result = E_BAD_DATA;
+    UINT64      entry64 = 0;
+    UINT64      tableAddress;
+    UINT32      entry32 = 0;
+    UINT32      virtualAddress32;
+    UINT32      level;
+
+    *PhysicalAddress = 0;
+
+    if (Triage->DirectoryTableBase == 0) {
+        goto Exit;
+    }
+
+    if (Context->Is64Bit) {
+
+        //
+        // ARM64: PXE -> PPE -> PDE -> PTE, 9 bits each, canonical addresses only.
+        //
+        if ((VirtualAddress >> TRIAGE_ARM64_USED_VA_BITS) !=
+            (((VirtualAddress >> (TRIAGE_ARM64_USED_VA_BITS - 1)) & 1) ? TRIAGE_ARM64_UNUSED_VA_MASK : 0)) {
+            goto Exit;
+        }
+
+        tableAddress = Triage->DirectoryTableBase & TRIAGE_ARM64_PFN_MASK;
+        for (level = 0; level < 4; level++) {
+            tableAddress += ((VirtualAddress >> (39 - (level * 9))) & TRIAGE_ARM64_TABLE_INDEX_MASK) * sizeof(UINT64);
+            result = TriageReadPhysical(Context, Triage, tableAddress, sizeof(entry64), &entry64);
+            if (FAILED(result)) {
+                goto Exit;
+            }
+
+            if ((entry64 & TRIAGE_ARM64_VALID) == 0) {
+                result = E_BAD_DATA;
+                goto Exit;
+            }
+
+            if ((level == 1) && ((entry64 & TRIAGE_ARM64_NOT_LARGE_PAGE) == 0)) {
+                *PhysicalAddress = (entry64 & TRIAGE_ARM64_1GB_PAGE_MASK) + (VirtualAddress & TRIAGE_ARM64_1GB_OFFSET_MASK);
+                goto Exit;
+            }
+
+            if ((level == 2) && ((entry64 & TRIAGE_ARM64_NOT_LARGE_PAGE) == 0)) {
+                *PhysicalAddress = (entry64 & TRIAGE_ARM64_2MB_PAGE_MASK) + (VirtualAddress & TRIAGE_ARM64_2MB_OFFSET_MASK);
+                goto Exit;
+            }
+
+            tableAddress = entry64 & TRIAGE_ARM64_PFN_MASK;
+        }
+
+        *PhysicalAddress = tableAddress + (VirtualAddress & (PAGE_SIZE - 1));
+        goto Exit;
+    }
+
+    virtualAddress32 = (UINT32)VirtualAddress;
+
+    if (!Triage->PaeEnabled) {
+
+        //
+        // PDE -> PTE.
+        //
+        tableAddress = (Triage->DirectoryTableBase & TRIAGE_PFN_MASK32) + ((virtualAddress32 >> 22) * sizeof(UINT32));
+        result = TriageReadPhysical(Context, Triage, tableAddress, sizeof(entry32), &entry32);
+        if (FAILED(result)) {
+            goto Exit;
+        }
+
+        if ((entry32 & TRIAGE_PTE_VALID32) == 0) {
+            result = E_BAD_DATA;
+            goto Exit;
+        }
+
+        if ((TRIAGE_PDE_LARGE_PAGE32 != 0) && ((entry32 & TRIAGE_PDE_LARGE_PAGE32) != 0)) {
+            *PhysicalAddress = (entry32 & TRIAGE_PDE_MASK32) + (virtualAddress32 & TRIAGE_LARGE_PAGE_OFFSET_MASK32);
+            goto Exit;
+        }
+
+        tableAddress = (entry32 & TRIAGE_PFN_MASK32) + (((virtualAddress32 >> 12) & 0x3FF) * sizeof(UINT32));
+        result = TriageReadPhysical(Context, Triage, tableAddress, sizeof(entry32), &entry32);
+        if (FAILED(result)) {
+            goto Exit;
+        }
+
+        if ((entry32 & TRIAGE_PTE_VALID32) == 0) {
+            result = E_BAD_DATA;
+            goto Exit;
+        }
+
+        *PhysicalAddress = (entry32 & TRIAGE_PFN_MASK32) + (virtualAddress32 & (PAGE_SIZE - 1));
+
+    } else {
+
+        //
+        // PDPTE -> PDE -> PTE, 8 byte entries. A PDE may map a 2MB page.
+        //
+        tableAddress = (Triage->DirectoryTableBase & TRIAGE_PAE_PDPT_MASK) + ((virtualAddress32 >> 30) * sizeof(UINT64));
+        for (level = 0; level < 3; level++) {
+            result = TriageReadPhysical(Context, Triage, tableAddress, sizeof(entry64), &entry64);
+            if (FAILED(result)) {
+                goto Exit;
+            }
+
+            if ((entry64 & TRIAGE_PAE_VALID) == 0) {
+                result = E_BAD_DATA;
+                goto Exit;
+            }
+
+            if ((level == 1) && ((entry64 & TRIAGE_PAE_LARGE_PAGE) != 0)) {
+                *PhysicalAddress = (entry64 & TRIAGE_PAE_2MB_PAGE_MASK) + (virtualAddress32 & TRIAGE_PAE_2MB_OFFSET_MASK);
+                goto Exit;
+            }
+
+            tableAddress = entry64 & TRIAGE_PAE_PFN_MASK;
+            if (level < 2) {
+                tableAddress += ((virtualAddress32 >> (21 - (level * 9))) & 0x1FF) * sizeof(UINT64);
+            }
+        }
+
+        *PhysicalAddress = tableAddress + (virtualAddress32 & (PAGE_SIZE - 1));
+    }
+
+Exit:
+    return result;
+}
+
+
+static
+HRESULT
+TriageAddVirtualRange(
+    _In_    PDMP_CONTEXT Context,
+    _Inout_ PTRIAGE_CONTEXT Triage,
+    _In_    UINT64 VirtualAddress,
+    _In_    UINT64 Length
+)
+{
+    HRESULT     result = S_OK;
+    UINT64      page;
+    UINT64      physicalAddress;
+
+    for (page = VirtualAddress & TRIAGE_PAGE_MASK; page < VirtualAddress + Length; page += PAGE_SIZE) {
+        result = TriageVirtualToPhysical(Context, Triage, page, &physicalAddress);
+        if (FAILED(result)) {
+            break;
+        }
+
+        TriageAddPhysicalRange(Context, Triage, physicalAddress, PAGE_SIZE);
+    }
+
+    return result;
+}
+
+
+static
+HRESULT
+TriageReadVirtual(
+    _In_    PDMP_CONTEXT Context,
+    _Inout_ PTRIAGE_CONTEXT Triage,
+    _In_    UINT64 VirtualAddress,
+    _In_    UINT32 Length,
+    _Out_writes_bytes_(Length) PVOID Buffer
+)
+{
+    HRESULT     result = S_OK;
+    UINT64      physicalAddress;
+    UINT32      chunk;
+    PUCHAR      destination = (PUCHAR)Buffer;
+
+    while (Length != 0) {
+        chunk = (UINT32)min((UINT64)Length, PAGE_SIZE - (VirtualAddress & (PAGE_SIZE - 1)));
+
+        result = TriageVirtualToPhysical(Context, Triage, VirtualAddress, &physicalAddress);
+        if (FAILED(result)) {
+            break;
+        }
+
+        result = TriageReadPhysical(Context, Triage, physicalAddress, chunk, destination);
+        if (FAILED(result)) {
+            break;
+        }
+
+        VirtualAddress += chunk;
+        destination += chunk;
+        Length -= chunk;
+    }
+
+    return result;
+}
+
+
+static
+VOID
+TriageCollectLoadedModules(
+    _In_    PDMP_CONTEXT Context,
+    _Inout_ PTRIAGE_CONTEXT Triage,
+    _In_    UINT64 PsLoadedModuleList
+)
+/*++
+
+Routine Description:
+    Walks PsLoadedModuleList in load order and keeps the list entries and the
+    BaseDllName buffers, which is what module resolution needs for bucketing.
+
+--*/
+{
+    UCHAR   entry[TRIAGE_LDR_ENTRY_LENGTH64];
+    UINT32  entryLength = Context->Is64Bit ? TRIAGE_LDR_ENTRY_LENGTH64 : TRIAGE_LDR_ENTRY_LENGTH32;
+    UINT64  current;
+    UINT64  nameBuffer;
+    USHORT  nameLength;
+    UINT32  count = 0;
+    HRESULT result;
+
+    current = 0;
+    result = TriageReadVirtual(Context, Triage, PsLoadedModuleList, Context->Is64Bit ? sizeof(UINT64) : sizeof(UINT32), &current);
+    if (FAILED(result)) {
+        TraceHRESULT1("Triage: cannot read PsLoadedModuleList", "VA", PsLoadedModuleList, result);
+        return;
+    }
+
+    while ((current != PsLoadedModuleList) && (current != 0) && (count < TRIAGE_MAX_MODULES)) {
+        result = TriageReadVirtual(Context, Triage, current, entryLength, entry);
+        if (FAILED(result)) {
+            TraceHRESULT1("Triage: cannot read loader entry", "VA", current, result);
+            break;
+        }
+
+        if (Context->Is64Bit) {
+            nameLength = *(USHORT UNALIGNED *)&entry[TRIAGE_LDR_BASE_DLL_NAME64];
+            nameBuffer = *(UINT64 UNALIGNED *)&entry[TRIAGE_LDR_BASE_DLL_NAME64 + sizeof(UINT64)];
+            current = *(UINT64 UNALIGNED *)&entry[0];
+        } else {
+            nameLength = *(USHORT UNALIGNED *)&entry[TRIAGE_LDR_BASE_DLL_NAME32];
+            nameBuffer = *(UINT32 UNALIGNED *)&entry[TRIAGE_LDR_BASE_DLL_NAME32 + sizeof(UINT32)];
+            current = *(UINT32 UNALIGNED *)&entry[0];
+        }
+
+        if ((nameBuffer != 0) && (nameLength != 0)) {
+            (VOID)TriageAddVirtualRange(Context, Triage, nameBuffer, nameLength);
+        }
+
+        count++;
+    }
+
+    TraceInfo1("Triage: loaded modules walked", "Count", count);
+}
+
+
+static
+VOID
+TriageCollectAPReg(
+    _In_    PDMP_CONTEXT Context,
+    _Inout_ PTRIAGE_CONTEXT Triage,
+    _In_    UINT64 APRegPA
+)
+/*++
+
+Routine Description:
+    Keeps the AP_REG structure and, for the legacy layout, the top of the
+    kernel stack of every CPU it describes.
+
+--*/
+{
+    AP_REG_B_FAMILY_HEADER  header;
+    NON_SECURE_CPU_CONTEXT  cpuContext;
+    UINT64                  contextPA;
+    UINT32                  cpuCount;
+    UINT32                  index;
+    HRESULT                 result;
+
+    if (Context->IsAPREG64Bit) {
+        TriageAddPhysicalRange(Context, Triage, APRegPA, TRIAGE_APREG64_PAGES * PAGE_SIZE);
+        return;
+    }
+
+    result = TriageReadPhysical(Context, Triage, APRegPA, sizeof(header), &header);
+    if (FAILED(result) || (header.Magic != AP_REG_STRUCTURE_MAGIC_VALUE)) {
+        TraceWarn1("Triage: AP_REG not readable", "PA", APRegPA);
+        return;
+    }
+
+    cpuCount = min(header.CPU_Count, AP_REG_MAX_CPUS);
+    TriageAddPhysicalRange(Context, Triage, APRegPA,
+        sizeof(AP_REG_B_FAMILY_HEADER) + sizeof(SECURE_CPU_CONTEXT) +
+        (cpuCount * (sizeof(CPU_STATUS) + sizeof(NON_SECURE_CPU_CONTEXT) + sizeof(WDOG_STATUS))));
+
+    for (index = 0; index < cpuCount; index++) {
+        contextPA = APRegPA + sizeof(AP_REG_B_FAMILY_HEADER) +
+            (cpuCount * sizeof(CPU_STATUS)) +
+            (index * sizeof(NON_SECURE_CPU_CONTEXT));
+
+        result = TriageReadPhysical(Context, Triage, contextPA, sizeof(cpuContext), &cpuContext);
+        if (FAILED(result) || (cpuContext.Saved_Ctx.Svc_R13 == 0)) {
+            continue;
+        }
+
+        result = TriageAddVirtualRange(Context, Triage, cpuContext.Saved_Ctx.Svc_R13, TRIAGE_STACK_PAGES * PAGE_SIZE);
+        if (FAILED(result)) {
+            TraceWarn2("Triage: stack not translatable", "CPU", index, "SP", cpuContext.Saved_Ctx.Svc_R13);
+        }
+    }
+}
+
+
+static
+int
+__cdecl
+TriageComparePages(
+    _In_ const void *Left,
+    _In_ const void *Right
+)
+{
+    UINT64 left = *(const UINT64 *)Left;
+    UINT64 right = *(const UINT64 *)Right;
+
+    return (left < right) ? -1 : ((left > right) ? 1 : 0);
+}
+
+
+static
+HRESULT
+TriageWritePackage(
+    _In_    PDMP_CONTEXT Context,
+    _In_    PTRIAGE_CONTEXT Triage,
+    _Inout_ PDEVICE_SPECIFIC_INFO DeviceSpecificInfo,
+    _In_    LPCWSTR FilePath
+)
+/*++
+
+Routine Description:
+    Writes the collected pages as a raw dump: one DDR_RANGE section per run
+    of consecutive pages, followed by a copy of the CPU_CONTEXT section and
+    the DEVICE_SPECIFIC_INFO trailer.
+
+Arguments:
+    Context - DMP_CONTEXT
+    Triage - Collected pages.
+    DeviceSpecificInfo - Trailer, CpuContextAddress is updated for the package.
+    FilePath - File to create.
+
+Return Value:
+    HRESULT
+
+--*/
+{
+    HRESULT                     result = S_OK;
+    DEVICE_IO                   hFile;
+    PRAW_DUMP_HEADER            header = nullptr;
+    PRAW_DUMP_SECTION_HEADER    section;
+    PRAW_DUMP_SECTION_HEADER    cpuContextSection = nullptr;
+    PCHAR                       page = nullptr;
+    UINT32                      headerSize;
+    UINT32                      sectionCount;
+    UINT32                      runCount = 0;
+    UINT32                      index;
+    UINT64                      offset;
+    UINT64                      remaining;
+    LARGE_INTEGER               address;
+    size_t                      bytesWritten;
+    size_t                      bytesRead;
+    size_t                      chunk;
+
+    qsort(Triage->Pages, Triage->PageCount, sizeof(Triage->Pages[0]), TriageComparePages);
+
+    for (index = 0; index < Triage->PageCount; index++) {
+        if ((index == 0) || (Triage->Pages[index] != Triage->Pages[index - 1] + PAGE_SIZE)) {
+            runCount++;
+        }
+    }
+
+    for (index = 0; index < Context->RawDumpHeader->SectionsCount; index++) {
+        if (Context->RawDumpHeader->SectionTable[index].Type == RAW_DUMP_SECTION_TYPE_CPU_CONTEXT) {
+            cpuContextSection = &Context->RawDumpHeader->SectionTable[index];
+            break;
+        }
+    }
+
+    sectionCount = runCount + ((cpuContextSection != nullptr) ? 1 : 0);
+    headerSize = FIELD_OFFSET(RAW_DUMP_HEADER, SectionTable) + (sectionCount * sizeof(RAW_DUMP_SECTION_HEADER));
+
+    header = (PRAW_DUMP_HEADER)MemoryBudgetAlloc(headerSize);
+    page = (PCHAR)MemoryBudgetAlloc(PAGE_SIZE);
+    if ((header == nullptr) || (page == nullptr)) {
+        result = E_OUTOFMEMORY;
+        TraceHRESULT("Triage: cannot allocate package header", result);
+        goto Exit;
+    }
+
+    //
+    // Lay out the sections, data starts on the first page after the header.
+    //
+    header->Signature = RAW_DUMP_HEADER_SIGNATURE;
+    header->Version = RAW_DUMP_HEADER_VERSION;
+    header->Flags = RAW_DUMP_HEADER_FLAGS_VALID;
+    header->OsData = Context->RawDumpHeader->OsData;
+    header->CpuContext = Context->RawDumpHeader->CpuContext;
+    header->ResetTrigger = Context->RawDumpHeader->ResetTrigger;
+    header->SectionsCount = sectionCount;
+
+    offset = RAW_DUMP_ALIGN_UP(headerSize, PAGE_SIZE);
+    section = nullptr;
+    for (index = 0; index < Triage->PageCount; index++) {
+        if ((index == 0) || (Triage->Pages[index] != Triage->Pages[index - 1] + PAGE_SIZE)) {
+            section = (section == nullptr) ? &header->SectionTable[0] : section + 1;
+            section->Flags = RAW_DUMP_HEADER_FLAGS_VALID;
+            section->Version = RAW_DUMP_SECTION_HEADER_VERSION;
+            section->Type = RAW_DUMP_SECTION_TYPE_DDR_RANGE;
+            section->Offset = offset;
+            section->u.DDRInformation.Base = Triage->Pages[index];
+            memcpy(section->Name, "DDR", sizeof("DDR"));
+        }
+
+        section->Size += PAGE_SIZE;
+        offset += PAGE_SIZE;
+    }
+
+    if (cpuContextSection != nullptr) {
+        section = &header->SectionTable[runCount];
+        *section = *cpuContextSection;
+        section->Offset = offset;
+        offset += section->Size;
+
+        DeviceSpecificInfo->CpuContextAddress = section->Offset;
+    }
+
+    header->DumpSize = offset;
+    header->TotalDumpSizeRequired = offset;
+
+    //
+    // Write it out, over any package left behind by an earlier run.
+    //
+    DeleteFileW(FilePath);
+    if (FAILED(result = hFile.Open(FilePath))) {
+        TraceHRESULT("Triage: cannot create package file", result);
+        goto Exit;
+    }
+
+    if (FAILED(result = hFile.Write((PCHAR)header, headerSize, &bytesWritten)) ||
+        ((headerSize % PAGE_SIZE != 0) &&
+         FAILED(result = hFile.Write(page, PAGE_SIZE - (headerSize % PAGE_SIZE), &bytesWritten)))) {
+        TraceHRESULT("Triage: cannot write package header", result);
+        goto Exit;
+    }
+
+    for (index = 0; index < Triage->PageCount; index++) {
+        address.QuadPart = Triage->Pages[index];
+        result = ReadFromDDRSectionByPhysicalAddress(Context, address, PAGE_SIZE, page);
+        if (FAILED(result)) {
+            TraceHRESULT1("Triage: cannot read page", "PA", Triage->Pages[index], result);
+            goto Exit;
+        }
+
+        if (FAILED(result = hFile.Write(page, PAGE_SIZE, &bytesWritten))) {
+            TraceHRESULT("Triage: cannot write page", result);
+            goto Exit;
+        }
+    }
+
+    if (cpuContextSection != nullptr) {
+        address.QuadPart = Context->diskoffset.QuadPart + cpuContextSection->Offset;
+        if (FAILED(result = Context->hDisk.SetPos(address))) {
+            TraceHRESULT("Triage: cannot seek to CPU_CONTEXT", result);
+            goto Exit;
+        }
+
+        for (remaining = cpuContextSection->Size; remaining != 0; remaining -= chunk) {
+            chunk = (size_t)min(remaining, PAGE_SIZE);
+            bytesRead = 0;
+            if (FAILED(result = Context->hDisk.Read(page, chunk, &bytesRead)) || (bytesRead != chunk)) {
+                result = FAILED(result) ? result : E_BAD_DATA;
+                TraceHRESULT("Triage: cannot read CPU_CONTEXT", result);
+                goto Exit;
+            }
+
+            if (FAILED(result = hFile.Write(page, chunk, &bytesWritten))) {
+                TraceHRESULT("Triage: cannot write CPU_CONTEXT", result);
+                goto Exit;
+            }
+        }
+    }
+
+    if (FAILED(result = WriteDeviceSpecificInfo(&hFile, DeviceSpecificInfo, hFile.GetCurrentFileSize()))) {
+        TraceHRESULT("Triage: cannot append device specific info", result);
+        goto Exit;
+    }
+
+    TraceInfo3("Triage package written", "Pages", Triage->PageCount,
+               "Sections", sectionCount, "Dropped pages", Triage->DroppedPageCount);
+
+Exit:
+    hFile.Close();
+
+    if (page != nullptr) {
+        MemoryBudgetFree(page);
+    }
+
+    if (header != nullptr) {
+        MemoryBudgetFree(header);
+    }
+
+    return result;
+}
+
+
+static
+HRESULT
+TriageSubmitReport(
+    _In_ PDMP_CONTEXT Context,
+    _In_ LPCWSTR FilePath
+)
+{
+    HRESULT             hr;
+    HREPORT             Report = NULL;
+    WCHAR               pszDest[30];
+    WER_SUBMIT_RESULT   submitResult;
+    ULONG               parameters[] = { Context->DumpHeader->BugCheckParameter1,
+                                         Context->DumpHeader->BugCheckParameter2,
+                                         Context->DumpHeader->BugCheckParameter3,
+                                         Context->DumpHeader->BugCheckParameter4 };
+    PCWSTR              names[] = { L"Bugcheck Parameter 1",
+                                    L"Bugcheck Parameter 2",
+                                    L"Bugcheck Parameter 3",
+                                    L"Bugcheck Parameter 4" };
+    DWORD               index;
+
+    hr = WerReportCreate(TRIAGE_WER_EVENT_TYPE, WerReportCritical, NULL, &Report);
+    if (!SUCCEEDED(hr)) {
+        goto Exit;
+    }
+
+    //
+    // The report is submitted out of process and the package is copied after
+    // WerReportSubmit returns, so WER deletes it once it is done with it.
+    //
+    hr = WerReportAddFile(Report, FilePath, WerFileTypeOther, WER_FILE_ANONYMOUS_DATA | WER_FILE_DELETE_WHEN_DONE);
+    if (!SUCCEEDED(hr)) {
+        goto Exit;
+    }
+
+    hr = WerReportAddFile(Report, Context->RawDumpInfoPath, WerFileTypeOther, WER_FILE_ANONYMOUS_DATA);
+    if (!SUCCEEDED(hr)) {
+        goto Exit;
+    }
+
+    //
+    // Same parameters as the full report so both land in the same bucket.
+    //
+    hr = WerReportSetParameter(Report, WER_P0, L"Build", L"0000");
+    if (!SUCCEEDED(hr)) {
+        goto Exit;
+    }
+
+    hr = WerReportSetParameter(Report, WER_P1, L"Bugcheck code", L"14C");
+    if (!SUCCEEDED(hr)) {
+        goto Exit;
+    }
+
+    for (index = 0; index < ARRAYSIZE(parameters); index++) {
+        hr = StringCchPrintfW(pszDest, ARRAYSIZE(pszDest), L"0x%x", parameters[index]);
+        if (SUCCEEDED(hr)) {
+            hr = WerReportSetParameter(Report, WER_P2 + index, names[index], pszDest);
+        }
+
+        if (!SUCCEEDED(hr)) {
+            break;
+        }
+    }
+
+    hr = WerReportSubmit(Report, WerConsentNotAsked, WER_SUBMIT_OUTOFPROCESS, &submitResult);
+
+Exit:
+    if (Report != NULL) {
+        WerReportCloseHandle(Report);
+    }
+
+    return hr;
+}
+
+
+HRESULT
+SubmitTriageDump(
+    _Inout_ PDMP_CONTEXT Context,
+    _In_    SvSpecific* SVData
+)
+/*++
+
+Routine Description:
+    Builds the triage package from the raw dump and submits it in its own
+    WER report, ahead of the full raw dump. It holds:
+
+    - the DUMP_HEADER page and the in-memory data that follows it
+    - KdDebuggerDataBlock
+    - PsLoadedModuleList entries and their BaseDllName buffers
+    - AP_REG and the top of each CPU's kernel stack, or the CPU_CONTEXT
+      section on x86
+    - the in-memory diagnostic buffer described by DEVICE_SPECIFIC_INFO
+    - every page table page used to translate the above
+
+    This needs the DUMP_HEADER location found while copying the raw dump
+    partition, so it is skipped for raw dumps collated from the SD card.
+
+Arguments:
+    Context - DMP_CONTEXT, hDisk is the raw dump.
+    SVData - SV specific data, source of DEVICE_SPECIFIC_INFO.
+
+Return Value:
+    HRESULT
+
+--*/
+{
+    HRESULT                 result = S_OK;
+    PTRIAGE_CONTEXT         triage = nullptr;
+    PUCHAR                  dumpHeader = nullptr;
+    UINT32                  dumpHeaderSize;
+    UINT64                  dumpHeaderPA;
+    UINT64                  kdDebuggerDataBlock;
+    UINT64                  psLoadedModuleList;
+    DEVICE_SPECIFIC_INFO    devSpeInfo;
+    WCHAR                   filePath[MAX_PATH];
+
+    if (Context->DumpHeaderPA.QuadPart == 0) {
+        TraceInfo("Triage: DUMP_HEADER location unknown, skipping the triage package");
+        return S_OK;
+    }
+
+    TraceMetric("BEGIN:Triage package");
+
+    dumpHeaderPA = (UINT64)Context->DumpHeaderPA.QuadPart;
+    dumpHeaderSize = Context->Is64Bit ? sizeof(DUMP_HEADER64) : sizeof(DUMP_HEADER32);
+
+    triage = (PTRIAGE_CONTEXT)MemoryBudgetAlloc(sizeof(TRIAGE_CONTEXT));
+    dumpHeader = (PUCHAR)MemoryBudgetAlloc(dumpHeaderSize);
+    if ((triage == nullptr) || (dumpHeader == nullptr)) {
+        result = E_OUTOFMEMORY;
+        TraceHRESULT("Triage: cannot allocate context", result);
+        goto Exit;
+    }
+
+    //
+    // DUMP_HEADER, the magic string in front of it and the data behind it.
+    //
+    result = TriageReadPhysical(Context, triage, dumpHeaderPA, dumpHeaderSize, dumpHeader);
+    if (FAILED(result)) {
+        TraceHRESULT1("Triage: cannot read DUMP_HEADER", "PA", dumpHeaderPA, result);
+        goto Exit;
+    }
+
+    TriageAddPhysicalRange(Context, triage, dumpHeaderPA & TRIAGE_PAGE_MASK,
+        RAW_DUMP_ALIGN_UP(dumpHeaderPA + dumpHeaderSize, PAGE_SIZE) - (dumpHeaderPA & TRIAGE_PAGE_MASK) +
+        (TRIAGE_DUMP_HEADER_TRAILER_PAGES * PAGE_SIZE));
+
+    if (Context->Is64Bit) {
+        PDUMP_HEADER64 header64 = (PDUMP_HEADER64)dumpHeader;
+
+        triage->DirectoryTableBase = header64->DirectoryTableBase;
+        triage->PaeEnabled = FALSE;
+        kdDebuggerDataBlock = header64->KdDebuggerDataBlock;
+        psLoadedModuleList = header64->PsLoadedModuleList;
+    } else {
+        PDUMP_HEADER32 header32 = (PDUMP_HEADER32)dumpHeader;
+
+        triage->DirectoryTableBase = header32->DirectoryTableBase;
+        triage->PaeEnabled = header32->PaeEnabled;
+        kdDebuggerDataBlock = header32->KdDebuggerDataBlock;
+        psLoadedModuleList = header32->PsLoadedModuleList;
+    }
+
+    TraceInfo3("Triage: DUMP_HEADER", "DirectoryTableBase", triage->DirectoryTableBase,
+               "KdDebuggerDataBlock", kdDebuggerDataBlock, "PsLoadedModuleList", psLoadedModuleList);
+
+    //
+    // KdDebuggerDataBlock and the loaded module list.
+    //
+    if (kdDebuggerDataBlock != 0) {
+        result = TriageAddVirtualRange(Context, triage, kdDebuggerDataBlock, TRIAGE_KDDEBUGGER_DATA_LENGTH);
+        if (FAILED(result)) {
+            TraceHRESULT1("Triage: KdDebuggerDataBlock not translatable", "VA", kdDebuggerDataBlock, result);
+        }
+    }
+
+    if (psLoadedModuleList != 0) {
+        TriageCollectLoadedModules(Context, triage, psLoadedModuleList);
+    }
+
+    //
+    // CPU state and the in-memory diagnostic buffer.
+    //
+    ZeroMemory(&devSpeInfo, sizeof(devSpeInfo));
+    result = SVData->BuildInfoBuffer(&devSpeInfo);
+    if (FAILED(result)) {
+        TraceHRESULT("Triage: cannot build device specific info", result);
+        goto Exit;
+    }
+
+    if (devSpeInfo.Type != PROCESSOR_ARCHITECTURE_INTEL) {
+        if (devSpeInfo.APRegPA == 0) {
+            devSpeInfo.APRegPA = (ULONGLONG)Context->APRegScanPA.QuadPart;
+        }
+
+        if (devSpeInfo.APRegPA != 0) {
+            TriageCollectAPReg(Context, triage, devSpeInfo.APRegPA);
+        }
+
+        if ((devSpeInfo.PA != 0) && (devSpeInfo.Size != 0)) {
+            TriageAddPhysicalRange(Context, triage, devSpeInfo.PA, devSpeInfo.Size);
+        }
+    }
+
+    //
+    // Write and submit it.
+    //
+    if (FAILED(result = StringCchCopyW(filePath, ARRAYSIZE(filePath), Context->RawDumpPath)) ||
+        FAILED(result = PathCchRemoveFileSpec(filePath, ARRAYSIZE(filePath))) ||
+        FAILED(result = PathCchAppend(filePath, ARRAYSIZE(filePath), TRIAGE_DUMP_FILE))) {
+        TraceHRESULT("Triage: cannot build package path", result);
+        goto Exit;
+    }
+
+    result = TriageWritePackage(Context, triage, &devSpeInfo, filePath);
+    if (FAILED(result)) {
+        goto Exit;
+    }
+
+    //
+    // Once submitted, the package belongs to WER, which deletes it.
+    //
+    result = TriageSubmitReport(Context, filePath);
+    if (FAILED(result)) {
+        TraceHRESULT("Triage: WER submission failed", result);
+        if (!DeleteFileW(filePath)) {
+            TraceWIN32("Triage: DeleteFile returned error", GetLastError());
+        }
+    }
+
+Exit:
+    if (SUCCEEDED(result)) {
+        TraceMetric("DONE:Triage package");
+    } else {
+        TraceMetric("FAILED:Triage package");
+    }
+
+    if (dumpHeader != nullptr) {
+        MemoryBudgetFree(dumpHeader);
+    }
+
+    if (triage != nullptr) {
+        MemoryBudgetFree(triage);
+    }
+
+    return result;
+}
@@ -0,0 +1,71 @@
+/*++
+
+Copyright (c) 2014 Microsoft Corporation, All Rights Reserved
+
+Module Name:
+    triage.h
+
+Abstract:
+    Small triage package built from the raw dump as soon as the DUMP_HEADER
+    has been located, and submitted ahead of the full raw dump so that the
+    crash can be bucketed without waiting for the full upload.
+
+    The package is itself a raw dump: a RAW_DUMP_HEADER, DDR_RANGE sections
+    holding only the pages needed for bucketing, the CPU_CONTEXT section if
+    the firmware wrote one, and the DEVICE_SPECIFIC_INFO trailer.
+
+Environment:
+    User Mode
+
+--*/
+
+
+#pragma once
+#include "offdmpsvc.h"
+#include "svspecific.h"
+
+#define TRIAGE_DUMP_FILE                    L"triagedump.bin"
+#define TRIAGE_WER_EVENT_TYPE               L"WindowsOfflineCrashTriage"
+
+//
+// Upper bounds on what goes into the package.
+//
+#define TRIAGE_MAX_PAGES                    512
+#define TRIAGE_MAX_MODULES                  256
+#define TRIAGE_STACK_PAGES                  3
+
+//
+// Pages following the DUMP_HEADER page. nt!IopInitializeInMemoryDumpData
+// stores the decoded KdDebuggerDataBlock and the per processor CONTEXT
+// addresses right behind the header.
+//
+#define TRIAGE_DUMP_HEADER_TRAILER_PAGES    2
+
+//
+// Bytes of KdDebuggerDataBlock to keep, covers KDDEBUGGER_DATA64.
+//
+#define TRIAGE_KDDEBUGGER_DATA_LENGTH       0x400
+
+//
+// The 64 bit AP_REG layout is a table the backend walks; keep its first pages.
+//
+#define TRIAGE_APREG64_PAGES                2
+
+//
+// KLDR_DATA_TABLE_ENTRY: InLoadOrderLinks is at offset 0.
+//
+#define TRIAGE_LDR_ENTRY_LENGTH32           0x50
+#define TRIAGE_LDR_ENTRY_LENGTH64           0xA0
+#define TRIAGE_LDR_BASE_DLL_NAME32          0x2C
+#define TRIAGE_LDR_BASE_DLL_NAME64          0x58
+
+bool
+ShouldSubmitTriageDump(
+    void
+);
+
+HRESULT
+SubmitTriageDump(
+    _Inout_ PDMP_CONTEXT Context,
+    _In_    SvSpecific* SVData
+);
@@ -0,0 +1,41 @@
+/*++
+
+    Copyright (C) Microsoft. All rights reserved.
+
+Module Name:
+   Dump_Magic.h
+
+Abstract:
+   Byte signatures of the in-memory dump data nt!IopInitializeInMemoryDumpData
+   builds in DDR: the magic string written at the start of a page, right in
+   front of the DUMP_HEADER, and the DUMP_HEADER Signature and ValidDump
+   fields that follow it. Every tool searching for or writing that data takes
+   them from here.
+
+   The bytes are also given as lists so that longer signatures, e.g. the
+   magic string followed by PAGEDUMP, can be built from them.
+
+Environment:
+   User Mode
+
+--*/
+
+#pragma once
+
+#include <windows.h>
+
+#define IN_MEMORY_DUMP_HEADER_MAGIC_BYTES       0x3B, 0x49, 0x53, 0x53, 0x94, 0x45, 0x2E, 0x30, \
+                                                0xD4, 0xCB, 0xDA, 0x97, 0xF1, 0x11, 0x02, 0xB5, \
+                                                0xE8, 0x36, 0x08, 0x61, 0x88, 0x70, 0x9B, 0x19
+#define IN_MEMORY_DUMP_HEADER_MAGIC_SIZE        24
+
+//
+// DUMP_HEADER.Signature + DUMP_HEADER.ValidDump: PAGEDUMP and PAGEDU64.
+//
+#define DUMP_HEADER_SIGNATURE32_BYTES           0x50, 0x41, 0x47, 0x45, 0x44, 0x55, 0x4D, 0x50
+#define DUMP_HEADER_SIGNATURE64_BYTES           0x50, 0x41, 0x47, 0x45, 0x44, 0x55, 0x36, 0x34
+
+//
+// The magic string, defined once in Dump_Magic.cpp.
+//
+extern const UCHAR InMemoryDumpHeaderMagicString[IN_MEMORY_DUMP_HEADER_MAGIC_SIZE];
@@ -0,0 +1,89 @@
+/*++
+
+    Copyright (C) Microsoft. All rights reserved.
+
+Module Name:
+   Kd_Decode.h
+
+Abstract:
+   Decoding of an encoded KdDebuggerDataBlock. The kernel encodes each ULONG
+   of the block with KiWaitNever, KiWaitAlways and a salt, the address of
+   KdpDataBlockEncoded (see KiDecodePointer). Four ULONGs are decoded at a time
+   with SSE2 on x86/amd64 and NEON on arm64; other targets and the tail of the
+   block use the scalar decoder.
+
+   When the salt or the block is not known for sure, several candidates can
+   be decoded at once: their headers are decoded and checked first, and only
+   the blocks whose header carries the expected owner tag are decoded whole.
+
+Environment:
+   User Mode
+
+--*/
+
+#pragma once
+
+#include <windows.h>
+
+#define KD_DECODE_NO_CANDIDATE          ((ULONG)-1)
+
+//
+// Size of the DBGKD_DEBUG_DATA_HEADER64 at the start of the block and the
+// offsets of its OwnerTag and Size fields.
+//
+#define KD_DECODE_HEADER_SIZE           24
+#define KD_DECODE_OWNER_TAG_OFFSET      16
+#define KD_DECODE_SIZE_OFFSET           20
+
+typedef struct _KD_DECODE_KEYS
+{
+    ULONG64     WaitNever;
+    ULONG64     WaitAlways;
+} KD_DECODE_KEYS, *PKD_DECODE_KEYS;
+
+typedef struct _KD_DECODE_CANDIDATE
+{
+    const VOID* Encoded;
+    PVOID       Decoded;
+    ULONG       Salt;
+    BOOL        Valid;
+} KD_DECODE_CANDIDATE, *PKD_DECODE_CANDIDATE;
+
+//
+// Decodes one ULONG, as KiDecodePointer does.
+//
+ULONG
+KdDecodeUlong(
+    _In_ ULONG Value,
+    _In_ const KD_DECODE_KEYS* Keys,
+    _In_ ULONG Salt
+);
+
+//
+// Decodes BlockSize bytes from Encoded to Decoded, which may be the same
+// buffer. A trailing partial ULONG is copied as is.
+//
+VOID
+KdDecodeBlock(
+    _In_reads_bytes_(BlockSize) const VOID* Encoded,
+    _Out_writes_bytes_(BlockSize) PVOID Decoded,
+    _In_ SIZE_T BlockSize,
+    _In_ const KD_DECODE_KEYS* Keys,
+    _In_ ULONG Salt
+);
+
+//
+// Decodes the headers of Count candidates of BlockSize bytes each and sets
+// Valid on those whose OwnerTag is OwnerTag and whose Size is not zero and
+// does not exceed BlockSize. Valid candidates are decoded whole into their
+// Decoded buffer. Returns the index of the first valid candidate, or
+// KD_DECODE_NO_CANDIDATE.
+//
+ULONG
+KdDecodeCandidates(
+    _Inout_updates_(Count) PKD_DECODE_CANDIDATE Candidates,
+    _In_ ULONG Count,
+    _In_ SIZE_T BlockSize,
+    _In_ const KD_DECODE_KEYS* Keys,
+    _In_ ULONG OwnerTag
+);
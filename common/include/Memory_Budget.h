@@ -0,0 +1,69 @@
+/*++
+
+    Copyright (C) Microsoft. All rights reserved.
+
+Module Name:
+   Memory_Budget.h
+
+Abstract:
+   Process wide memory budget. Large buffers (DEVICE_IO caches, copy buffers,
+   section buffers) are drawn from one pool so that the total stays under a
+   configurable ceiling on low memory devices. The peak is kept for reporting.
+
+   A ceiling of MEMORY_BUDGET_UNLIMITED (the default) only tracks usage.
+
+Environment:
+   User Mode
+
+--*/
+
+#pragma once
+
+#include <windows.h>
+
+#define MEMORY_BUDGET_UNLIMITED                 0
+
+typedef struct _MEMORY_BUDGET_USAGE
+{
+    ULONGLONG   Ceiling;
+    ULONGLONG   InUse;
+    ULONGLONG   Peak;
+    ULONG       Allocations;
+    ULONG       Denied;
+} MEMORY_BUDGET_USAGE, *PMEMORY_BUDGET_USAGE;
+
+VOID
+MemoryBudgetSetCeiling(
+    _In_ ULONGLONG Ceiling
+);
+
+VOID
+MemoryBudgetQuery(
+    _Out_ PMEMORY_BUDGET_USAGE Usage
+);
+
+//
+// Zeroed allocation of exactly Size bytes, nullptr if it does not fit.
+//
+_Ret_maybenull_
+PVOID
+MemoryBudgetAlloc(
+    _In_ SIZE_T Size
+);
+
+//
+// Zeroed allocation of up to Preferred bytes. The size is halved, in
+// multiples of Minimum, until it fits; nullptr if not even Minimum fits.
+//
+_Ret_maybenull_
+PVOID
+MemoryBudgetAllocAdaptive(
+    _In_  SIZE_T Preferred,
+    _In_  SIZE_T Minimum,
+    _Out_ PSIZE_T Allocated
+);
+
+VOID
+MemoryBudgetFree(
+    _In_opt_ PVOID Buffer
+);
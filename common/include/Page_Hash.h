@@ -0,0 +1,53 @@
+/*++
+
+    Copyright (C) Microsoft. All rights reserved.
+
+Module Name:
+   Page_Hash.h
+
+Abstract:
+   Fast 64-bit hash of memory pages, used to find the pages that differ
+   between two raw dumps without comparing them byte for byte. The hash is
+   built like XXH3: eight 64-bit lanes take a 64 byte stripe at a time, each
+   lane adds the product of the low and high halves of its data xor key and
+   its neighbour's data, and the lanes are scrambled every 1 KB. The lanes
+   run in SSE2 on x86/amd64 and in NEON on arm64; other targets use the
+   scalar code. All paths give the same hash.
+
+   It is not a cryptographic hash, it is not meant to stand up to crafted
+   input.
+
+Environment:
+   User Mode
+
+--*/
+
+#pragma once
+
+#include <windows.h>
+
+#define PAGE_HASH_PAGE_SIZE             0x1000
+#define PAGE_HASH_STRIPE_SIZE           64
+#define PAGE_HASH_STRIPES_PER_BLOCK     16
+
+//
+// Hashes Length bytes at Data.
+//
+ULONG64
+PageHash64(
+    _In_reads_bytes_(Length) const VOID* Data,
+    _In_ SIZE_T Length,
+    _In_ ULONG64 Seed
+);
+
+//
+// Hashes PageCount pages of PAGE_HASH_PAGE_SIZE bytes at Data into Hashes,
+// one hash per page.
+//
+VOID
+PageHashPages(
+    _In_reads_bytes_(PageCount * PAGE_HASH_PAGE_SIZE) const VOID* Data,
+    _In_ SIZE_T PageCount,
+    _Out_writes_(PageCount) PULONG64 Hashes,
+    _In_ ULONG64 Seed
+);
@@ -0,0 +1,71 @@
+/*++
+
+Copyright (C) Microsoft. All rights reserved.
+
+Module Name:
+    Raw2Dump_State.h
+
+Abstract:
+    State handed from the offline dump service to raw2dump.dll so that the
+    conversion can start from an already opened and already parsed raw dump
+    instead of re-opening and re-parsing rawdump.bin from its path.
+
+Environment:
+    User Mode
+
+--*/
+
+#pragma once
+
+#include "Device_Specific.h"
+
+#define RAW2DUMP_STATE_VERSION                  1
+
+//
+// One DDR section of the raw dump, as described by the section table.
+// Entries are expected to be sorted ascending by Base.
+//
+typedef struct _RAW2DUMP_DDR_RANGE
+{
+    UINT64                      Base;
+    UINT64                      Size;
+    UINT64                      Offset;
+} RAW2DUMP_DDR_RANGE, *PRAW2DUMP_DDR_RANGE;
+
+//
+// Everything the caller already knows about the raw dump.
+//
+// RawDumpHeader points to the RAW_DUMP_HEADER as read from the device and
+// SectionTable to its RAW_DUMP_SECTION_HEADER array. Both are treated as raw
+// bytes because the two components carry their own copies of rawdump.h.
+//
+// RawDump is borrowed: it must stay open for the duration of the call and is
+// neither repositioned back nor closed by raw2dump.
+//
+// DumpHeaderPA is the physical address of the in-memory DUMP_HEADER, or zero
+// when it has not been located yet, in which case the DDR sections are
+// searched for it.
+//
+typedef struct _RAW2DUMP_STATE
+{
+    UINT32                      Size;
+    UINT32                      Version;
+
+    DEVICE_IO                   *RawDump;
+    ULONGLONG                   RawDumpLength;
+
+    PVOID                       RawDumpHeader;
+    PVOID                       SectionTable;
+    UINT32                      SectionCount;
+
+    PRAW2DUMP_DDR_RANGE         DDRRanges;
+    UINT32                      DDRRangeCount;
+
+    ULONGLONG                   DumpHeaderPA;
+    DEVICE_SPECIFIC_INFO        DeviceSpecificInfo;
+} RAW2DUMP_STATE, *PRAW2DUMP_STATE;
+
+//
+// raw2dump.dll export taking the state above.
+//
+typedef HRESULT (CALLBACK* ConvertRawStateToDumpFn)(PRAW2DUMP_STATE, LPWSTR, LPWSTR);
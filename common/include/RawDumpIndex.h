@@ -0,0 +1,57 @@
+/*++
+
+    Copyright (C) Microsoft. All rights reserved.
+
+Module Name:
+   RawDumpIndex.h
+
+Abstract:
+   Sidecar index of a raw dump file, written next to it (<raw dump>.r2dx) once
+   a conversion succeeds. It is keyed by the size of the raw dump and the
+   CRC32 of its RAW_DUMP_HEADER and section table, and keeps what the first
+   conversion had to find out: the sorted DDR ranges and where the DUMP_HEADER,
+   AP_REG and KdDebuggerDataBlock are. The header is followed by the section
+   table and the DDR ranges.
+
+   raw2dump writes and reads the index. offdumptool reads it for queries and
+   to skip the dump header search of a raw dump file it converts. OffDmpSvc
+   finds the dump header while it copies the raw dump and does not read it.
+   The includer brings its own RAW_DUMP_SECTION_HEADER and RawDumpTableSize.
+
+Environment:
+   User Mode
+
+--*/
+
+#pragma once
+
+#define RAW_DUMP_INDEX_EXTENSION    L".r2dx"
+#define RAW_DUMP_INDEX_SIGNATURE    0x58494432      // "2DIX"
+#define RAW_DUMP_INDEX_VERSION      1
+
+typedef struct _RAW_DUMP_INDEX_HEADER
+{
+    UINT32      Signature;
+    UINT32      Version;
+    UINT32      HeaderSize;
+    UINT32      Crc32;                  // Of everything after the header
+    UINT64      RawDumpSize;
+    UINT32      RawDumpHeaderCrc32;     // Of the RAW_DUMP_HEADER and section table
+    UINT32      SectionCount;
+    UINT32      DDRRangeCount;
+    UINT32      Is64Bit;
+    UINT64      DumpHeaderPA;
+    UINT64      DirectoryTableBase;
+    UINT64      KdDebuggerDataBlockPA;
+    UINT64      APRegPA;
+} RAW_DUMP_INDEX_HEADER, *PRAW_DUMP_INDEX_HEADER;
+
+typedef struct _RAW_DUMP_INDEX_RANGE
+{
+    UINT64      Base;
+    UINT64      Size;
+    UINT64      Offset;
+} RAW_DUMP_INDEX_RANGE, *PRAW_DUMP_INDEX_RANGE;
+
+#define RawDumpIndexSize(nSections, nRanges) \
+    (sizeof(RAW_DUMP_INDEX_HEADER) + RawDumpTableSize(nSections) + (nRanges) * sizeof(RAW_DUMP_INDEX_RANGE))
@@ -0,0 +1,189 @@
+/*++
+
+    Copyright (C) Microsoft. All rights reserved.
+
+Module Name:
+   Signature_Scan.h
+
+Abstract:
+   Search of memory buffers for a byte signature. Offsets whose first and last
+   bytes match the signature are picked out sixteen at a time with SIMD
+   compares (SSE2 on x86/amd64, NEON on arm64) and only those are verified.
+   Other targets use a memchr based scalar search.
+
+   When the caller knows the signature starts on an aligned boundary, e.g. a
+   page aligned structure built by the kernel, only those offsets are looked
+   at.
+
+   The SIGNATURE_SCANNER looks for several signatures in one pass over a
+   stream of buffers and collects the hits in a table. Signatures spanning two
+   buffers of the stream are found as well.
+
+Environment:
+   User Mode
+
+--*/
+
+#pragma once
+
+#include <windows.h>
+
+#define SIGNATURE_NOT_FOUND             ((SIZE_T)-1)
+
+//
+// Alignment value to look at every offset.
+//
+#define SIGNATURE_SCAN_ANY_OFFSET       0
+
+typedef struct _SIGNATURE_SCAN_STATS
+{
+    ULONGLONG   BytesScanned;
+    ULONGLONG   Candidates;
+    ULONGLONG   Ticks;
+} SIGNATURE_SCAN_STATS, *PSIGNATURE_SCAN_STATS;
+
+//
+// Returns the offset of the first occurrence of Pattern in Buffer, or
+// SIGNATURE_NOT_FOUND. With a non zero Alignment only offsets for which
+// (offset + Phase) is a multiple of Alignment are considered. Stats, when
+// given, is accumulated into.
+//
+SIZE_T
+SignatureScanFind(
+    _In_reads_bytes_(BufferSize) const UCHAR* Buffer,
+    _In_ SIZE_T BufferSize,
+    _In_reads_bytes_(PatternSize) const UCHAR* Pattern,
+    _In_ SIZE_T PatternSize,
+    _In_ SIZE_T Alignment,
+    _In_ SIZE_T Phase,
+    _Inout_opt_ PSIGNATURE_SCAN_STATS Stats
+);
+
+//
+// Scan throughput of the accumulated statistics, in GB/s.
+//
+double
+SignatureScanGBps(
+    _In_ PSIGNATURE_SCAN_STATS Stats
+);
+
+
+//
+// Multi signature scanner.
+//
+#define SIGNATURE_SCANNER_MAX_PATTERNS      8
+#define SIGNATURE_SCANNER_MAX_PATTERN_SIZE  64
+#define SIGNATURE_SCANNER_MAX_HITS          64
+
+typedef struct _SIGNATURE_PATTERN
+{
+    ULONG           Id;
+    const UCHAR*    Bytes;
+    SIZE_T          Size;
+    SIZE_T          Alignment;
+    ULONG           MaxHits;
+    ULONG           HitCount;
+} SIGNATURE_PATTERN, *PSIGNATURE_PATTERN;
+
+typedef struct _SIGNATURE_HIT
+{
+    ULONG           Id;
+    ULONGLONG       Offset;
+} SIGNATURE_HIT, *PSIGNATURE_HIT;
+
+//
+// Hits the filter returns FALSE for are neither recorded nor counted as
+// dropped, so they never take the room of the ones the caller wants.
+//
+typedef BOOL (*PSIGNATURE_HIT_FILTER)(
+    _In_opt_ PVOID FilterContext,
+    _In_ ULONG Id,
+    _In_ ULONGLONG Offset
+);
+
+typedef struct _SIGNATURE_SCANNER
+{
+    SIGNATURE_PATTERN       Patterns[SIGNATURE_SCANNER_MAX_PATTERNS];
+    ULONG                   PatternCount;
+    SIZE_T                  MaxPatternSize;
+    SIGNATURE_HIT           Hits[SIGNATURE_SCANNER_MAX_HITS];
+    ULONG                   HitCount;
+    ULONG                   DroppedHits;
+    PSIGNATURE_HIT_FILTER   Filter;
+    PVOID                   FilterContext;
+    ULONGLONG               StreamEnd;
+    SIZE_T                  CarrySize;
+    UCHAR                   Carry[SIGNATURE_SCANNER_MAX_PATTERN_SIZE * 2];
+    SIGNATURE_SCAN_STATS    Stats;
+} SIGNATURE_SCANNER, *PSIGNATURE_SCANNER;
+
+VOID
+SignatureScannerInit(
+    _Out_ PSIGNATURE_SCANNER Scanner
+);
+
+//
+// Registers a signature. Bytes must stay valid while the scanner is used.
+// Alignment is applied to the offsets given to SignatureScannerScan, 0 looks
+// at every offset. MaxHits of 0 keeps every hit the table has room for.
+//
+HRESULT
+SignatureScannerAddPattern(
+    _Inout_ PSIGNATURE_SCANNER Scanner,
+    _In_ ULONG Id,
+    _In_reads_bytes_(Size) const UCHAR* Bytes,
+    _In_ SIZE_T Size,
+    _In_ SIZE_T Alignment,
+    _In_ ULONG MaxHits
+);
+
+//
+// Sets the filter applied to every hit before it is added to the table,
+// nullptr records them all. FilterContext is passed to it as is.
+//
+VOID
+SignatureScannerSetFilter(
+    _Inout_ PSIGNATURE_SCANNER Scanner,
+    _In_opt_ PSIGNATURE_HIT_FILTER Filter,
+    _In_opt_ PVOID FilterContext
+);
+
+//
+// Scans the next buffer of the stream. BaseOffset is the offset of the
+// buffer in the stream; when it is where the previous buffer ended,
+// signatures spanning both buffers are reported too.
+//
+VOID
+SignatureScannerScan(
+    _Inout_ PSIGNATURE_SCANNER Scanner,
+    _In_reads_bytes_(BufferSize) const UCHAR* Buffer,
+    _In_ SIZE_T BufferSize,
+    _In_ ULONGLONG BaseOffset
+);
+
+//
+// Forgets the end of the last buffer, e.g. when moving to an unrelated region.
+//
+VOID
+SignatureScannerEndStream(
+    _Inout_ PSIGNATURE_SCANNER Scanner
+);
+
+//
+// Lowest offset hit of a signature, nullptr if there is none.
+//
+_Ret_maybenull_
+const SIGNATURE_HIT*
+SignatureScannerFirstHit(
+    _In_ PSIGNATURE_SCANNER Scanner,
+    _In_ ULONG Id
+);
+
+//
+// TRUE once every signature has MaxHits hits. Never TRUE while a signature
+// registered without a MaxHits is being searched for.
+//
+BOOL
+SignatureScannerComplete(
+    _In_ PSIGNATURE_SCANNER Scanner
+);
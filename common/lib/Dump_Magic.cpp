@@ -0,0 +1,14 @@
+/*++
+
+    Copyright (C) Microsoft. All rights reserved.
+
+Module Name:
+   Dump_Magic.cpp
+
+Environment:
+   User Mode
+
+--*/
+#include "Dump_Magic.h"
+
+const UCHAR InMemoryDumpHeaderMagicString[] = { IN_MEMORY_DUMP_HEADER_MAGIC_BYTES };
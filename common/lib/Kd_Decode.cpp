@@ -0,0 +1,169 @@
+/*++
+
+    Copyright (C) Microsoft. All rights reserved.
+
+Module Name:
+   Kd_Decode.cpp
+
+Environment:
+   User Mode
+
+--*/
+#include <windows.h>
+#include <string.h>
+
+#if defined(_M_IX86) || defined(_M_X64)
+#include <emmintrin.h>
+#define KD_DECODE_SSE2
+#elif defined(_M_ARM64)
+#include <arm64_neon.h>
+#define KD_DECODE_NEON
+#endif
+
+#include "Kd_Decode.h"
+
+#define ULONGS_PER_VECTOR   4
+
+
+/****************************************************************************************
+**  ULONG KdDecodeUlong(Value, Keys, Salt)
+**    Copied from the NT kernel KiDecodePointer: xor with KiWaitNever, rotate
+**    left by KiWaitNever, xor with the salt, byte swap, xor with KiWaitAlways.
+*****************************************************************************************/
+ULONG
+KdDecodeUlong(
+    _In_ ULONG Value,
+    _In_ const KD_DECODE_KEYS* Keys,
+    _In_ ULONG Salt)
+{
+    Value = _rotl(Value ^ (ULONG)Keys->WaitNever, (int)(Keys->WaitNever & 31));
+    Value = _byteswap_ulong(Value ^ Salt) ^ (ULONG)Keys->WaitAlways;
+
+    return Value;
+}
+
+
+/****************************************************************************************
+**  VOID KdDecodeBlock(Encoded, Decoded, BlockSize, Keys, Salt)
+**    Four ULONGs per iteration. The rotate is a pair of shifts, a shift by 32
+**    gives 0 so a rotate count of 0 works too.
+*****************************************************************************************/
+VOID
+KdDecodeBlock(
+    _In_reads_bytes_(BlockSize) const VOID* Encoded,
+    _Out_writes_bytes_(BlockSize) PVOID Decoded,
+    _In_ SIZE_T BlockSize,
+    _In_ const KD_DECODE_KEYS* Keys,
+    _In_ ULONG Salt)
+{
+    const UCHAR*    source = (const UCHAR*)Encoded;
+    UCHAR*          target = (UCHAR*)Decoded;
+    SIZE_T          count = BlockSize / sizeof(ULONG);
+    SIZE_T          index = 0;
+    ULONG           value;
+
+#if defined(KD_DECODE_SSE2)
+    const int       rotate = (int)(Keys->WaitNever & 31);
+    const __m128i   never = _mm_set1_epi32((int)(ULONG)Keys->WaitNever);
+    const __m128i   always = _mm_set1_epi32((int)(ULONG)Keys->WaitAlways);
+    const __m128i   salt = _mm_set1_epi32((int)Salt);
+    const __m128i   left = _mm_cvtsi32_si128(rotate);
+    const __m128i   right = _mm_cvtsi32_si128(32 - rotate);
+    const __m128i   byte1 = _mm_set1_epi32(0x0000FF00);
+    __m128i         v;
+
+    for (; index + ULONGS_PER_VECTOR <= count; index += ULONGS_PER_VECTOR)
+    {
+        v = _mm_loadu_si128((const __m128i*)(source + index * sizeof(ULONG)));
+        v = _mm_xor_si128(v, never);
+        v = _mm_or_si128(_mm_sll_epi32(v, left), _mm_srl_epi32(v, right));
+        v = _mm_xor_si128(v, salt);
+        v = _mm_or_si128(_mm_or_si128(_mm_slli_epi32(v, 24), _mm_srli_epi32(v, 24)),
+                         _mm_or_si128(_mm_slli_epi32(_mm_and_si128(v, byte1), 8),
+                                      _mm_and_si128(_mm_srli_epi32(v, 8), byte1)));
+        v = _mm_xor_si128(v, always);
+        _mm_storeu_si128((__m128i*)(target + index * sizeof(ULONG)), v);
+    }
+
+#elif defined(KD_DECODE_NEON)
+    const int32x4_t left = vdupq_n_s32((int32_t)(Keys->WaitNever & 31));
+    const int32x4_t right = vdupq_n_s32((int32_t)(Keys->WaitNever & 31) - 32);
+    const uint32x4_t never = vdupq_n_u32((uint32_t)Keys->WaitNever);
+    const uint32x4_t always = vdupq_n_u32((uint32_t)Keys->WaitAlways);
+    const uint32x4_t salt = vdupq_n_u32(Salt);
+    uint32x4_t      v;
+
+    for (; index + ULONGS_PER_VECTOR <= count; index += ULONGS_PER_VECTOR)
+    {
+        v = vld1q_u32((const uint32_t*)(source + index * sizeof(ULONG)));
+        v = veorq_u32(v, never);
+        v = vorrq_u32(vshlq_u32(v, left), vshlq_u32(v, right));
+        v = veorq_u32(v, salt);
+        v = vreinterpretq_u32_u8(vrev32q_u8(vreinterpretq_u8_u32(v)));
+        v = veorq_u32(v, always);
+        vst1q_u32((uint32_t*)(target + index * sizeof(ULONG)), v);
+    }
+#endif
+
+    for (; index < count; index++)
+    {
+        memcpy(&value, source + index * sizeof(ULONG), sizeof(ULONG));
+        value = KdDecodeUlong(value, Keys, Salt);
+        memcpy(target + index * sizeof(ULONG), &value, sizeof(ULONG));
+    }
+
+    if ((target != source) && ((BlockSize % sizeof(ULONG)) != 0))
+    {
+        memcpy(target + count * sizeof(ULONG), source + count * sizeof(ULONG), BlockSize % sizeof(ULONG));
+    }
+}
+
+
+/****************************************************************************************
+**  ULONG KdDecodeCandidates(Candidates, Count, BlockSize, Keys, OwnerTag)
+**    Headers first, so that wrong guesses cost a few ULONGs each.
+*****************************************************************************************/
+ULONG
+KdDecodeCandidates(
+    _Inout_updates_(Count) PKD_DECODE_CANDIDATE Candidates,
+    _In_ ULONG Count,
+    _In_ SIZE_T BlockSize,
+    _In_ const KD_DECODE_KEYS* Keys,
+    _In_ ULONG OwnerTag)
+{
+    UCHAR   header[KD_DECODE_HEADER_SIZE];
+    ULONG   tag;
+    ULONG   size;
+    ULONG   first = KD_DECODE_NO_CANDIDATE;
+    ULONG   index;
+
+    for (index = 0; index < Count; index++)
+    {
+        Candidates[index].Valid = FALSE;
+        if ((BlockSize < KD_DECODE_HEADER_SIZE) || (Candidates[index].Encoded == nullptr))
+        {
+            continue;
+        }
+
+        KdDecodeBlock(Candidates[index].Encoded, header, sizeof(header), Keys, Candidates[index].Salt);
+        memcpy(&tag, header + KD_DECODE_OWNER_TAG_OFFSET, sizeof(tag));
+        memcpy(&size, header + KD_DECODE_SIZE_OFFSET, sizeof(size));
+        if ((tag != OwnerTag) || (size == 0) || (size > BlockSize))
+        {
+            continue;
+        }
+
+        Candidates[index].Valid = TRUE;
+        if (Candidates[index].Decoded != nullptr)
+        {
+            KdDecodeBlock(Candidates[index].Encoded, Candidates[index].Decoded, BlockSize, Keys, Candidates[index].Salt);
+        }
+
+        if (first == KD_DECODE_NO_CANDIDATE)
+        {
+            first = index;
+        }
+    }
+
+    return first;
+}
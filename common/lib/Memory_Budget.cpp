@@ -0,0 +1,160 @@
+/*++
+
+    Copyright (C) Microsoft. All rights reserved.
+
+Module Name:
+   Memory_Budget.cpp
+
+Environment:
+   User Mode
+
+--*/
+#include <windows.h>
+
+#include "Memory_Budget.h"
+
+//
+// Every allocation is preceded by its size so that MemoryBudgetFree can
+// return it to the budget. The header keeps 16 byte alignment.
+//
+typedef struct DECLSPEC_ALIGN(16) _MEMORY_BUDGET_HEADER
+{
+    SIZE_T      Size;
+} MEMORY_BUDGET_HEADER, *PMEMORY_BUDGET_HEADER;
+
+static volatile LONGLONG    s_Ceiling = MEMORY_BUDGET_UNLIMITED;
+static volatile LONGLONG    s_InUse = 0;
+static volatile LONGLONG    s_Peak = 0;
+static volatile LONG        s_Allocations = 0;
+static volatile LONG        s_Denied = 0;
+
+
+/****************************************************************************************
+**  BOOL Reserve(_In_ SIZE_T Size)
+**    Account for Size bytes if they fit under the ceiling and raise the peak.
+*****************************************************************************************/
+static
+BOOL
+Reserve(_In_ SIZE_T Size)
+{
+    LONGLONG    inUse;
+    LONGLONG    peak;
+    LONGLONG    ceiling = s_Ceiling;
+
+    do
+    {
+        inUse = s_InUse;
+        if ((ceiling != MEMORY_BUDGET_UNLIMITED) && ((ULONGLONG)inUse + Size > (ULONGLONG)ceiling))
+        {
+            InterlockedIncrement(&s_Denied);
+            return FALSE;
+        }
+
+    } while (InterlockedCompareExchange64(&s_InUse, inUse + (LONGLONG)Size, inUse) != inUse);
+
+    do
+    {
+        peak = s_Peak;
+        if (peak >= inUse + (LONGLONG)Size)
+        {
+            break;
+        }
+
+    } while (InterlockedCompareExchange64(&s_Peak, inUse + (LONGLONG)Size, peak) != peak);
+
+    return TRUE;
+}
+
+
+VOID
+MemoryBudgetSetCeiling(_In_ ULONGLONG Ceiling)
+{
+    InterlockedExchange64(&s_Ceiling, (LONGLONG)Ceiling);
+}
+
+
+VOID
+MemoryBudgetQuery(_Out_ PMEMORY_BUDGET_USAGE Usage)
+{
+    Usage->Ceiling = (ULONGLONG)s_Ceiling;
+    Usage->InUse = (ULONGLONG)s_InUse;
+    Usage->Peak = (ULONGLONG)s_Peak;
+    Usage->Allocations = (ULONG)s_Allocations;
+    Usage->Denied = (ULONG)s_Denied;
+}
+
+
+_Ret_maybenull_
+PVOID
+MemoryBudgetAlloc(_In_ SIZE_T Size)
+{
+    PMEMORY_BUDGET_HEADER   header = nullptr;
+
+    if ((Size == 0) || (Size > MAXSIZE_T - sizeof(MEMORY_BUDGET_HEADER)))
+    {
+        return nullptr;
+    }
+
+    if (Reserve(Size))
+    {
+        header = (PMEMORY_BUDGET_HEADER)HeapAlloc(GetProcessHeap(), HEAP_ZERO_MEMORY, sizeof(MEMORY_BUDGET_HEADER) + Size);
+        if (header == nullptr)
+        {
+            InterlockedExchangeAdd64(&s_InUse, -(LONGLONG)Size);
+        }
+        else
+        {
+            header->Size = Size;
+            InterlockedIncrement(&s_Allocations);
+        }
+
+    }
+
+    return (header == nullptr) ? nullptr : (PVOID)(header + 1);
+}
+
+
+_Ret_maybenull_
+PVOID
+MemoryBudgetAllocAdaptive(_In_ SIZE_T Preferred, _In_ SIZE_T Minimum, _Out_ PSIZE_T Allocated)
+{
+    PVOID   buffer = nullptr;
+    SIZE_T  size = Preferred;
+
+    *Allocated = 0;
+    if (Minimum == 0)
+    {
+        return nullptr;
+    }
+
+    while ((buffer == nullptr) && (size >= Minimum))
+    {
+        buffer = MemoryBudgetAlloc(size);
+        if (buffer != nullptr)
+        {
+            *Allocated = size;
+        }
+        else
+        {
+            size = ((size / 2) / Minimum) * Minimum;
+        }
+
+    }
+
+    return buffer;
+}
+
+
+VOID
+MemoryBudgetFree(_In_opt_ PVOID Buffer)
+{
+    PMEMORY_BUDGET_HEADER   header;
+
+    if (Buffer != nullptr)
+    {
+        header = ((PMEMORY_BUDGET_HEADER)Buffer) - 1;
+        InterlockedExchangeAdd64(&s_InUse, -(LONGLONG)header->Size);
+        HeapFree(GetProcessHeap(), 0, header);
+    }
+
+}
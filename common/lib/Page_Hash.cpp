@@ -0,0 +1,233 @@
+/*++
+
+    Copyright (C) Microsoft. All rights reserved.
+
+Module Name:
+   Page_Hash.cpp
+
+Environment:
+   User Mode
+
+--*/
+#include <windows.h>
+#include <string.h>
+
+#if defined(_M_IX86) || defined(_M_X64)
+#include <emmintrin.h>
+#define PAGE_HASH_SSE2
+#elif defined(_M_ARM64)
+#include <arm64_neon.h>
+#define PAGE_HASH_NEON
+#endif
+
+#include "Page_Hash.h"
+
+#define PAGE_HASH_LANES     8
+
+#define PRIME32_1           0x9E3779B1U
+#define PRIME32_2           0x85EBCA77U
+#define PRIME32_3           0xC2B2AE3DU
+#define PRIME64_1           0x9E3779B185EBCA87ULL
+#define PRIME64_2           0xC2B2AE3D27D4EB4FULL
+#define PRIME64_3           0x165667B19E3779F9ULL
+#define PRIME64_4           0x85EBCA77C2B2AE63ULL
+#define PRIME64_5           0x27D4EB2F165667C5ULL
+
+static const ULONG64 PageHashSecret[PAGE_HASH_LANES] = {
+    0x6E789E6AA1B965F4ULL, 0x06C45D188009454FULL, 0xF88BB8A8724C81ECULL, 0x1B39896A51A8749BULL,
+    0x53CB9F0C747EA2EAULL, 0x2C829ABE1F4532E1ULL, 0xC584133AC916AB3CULL, 0x3EE5789041C98AC3ULL
+};
+
+
+/****************************************************************************************
+**  VOID PageHashStripes(Acc, Data, StripeCount, Keys)
+**    Accumulates StripeCount stripes of 64 bytes into the lanes and scrambles
+**    the lanes after every PAGE_HASH_STRIPES_PER_BLOCK stripes.
+*****************************************************************************************/
+static
+VOID
+PageHashStripes(
+    _Inout_updates_(PAGE_HASH_LANES) ULONG64* Acc,
+    _In_reads_bytes_(StripeCount * PAGE_HASH_STRIPE_SIZE) const UCHAR* Data,
+    _In_ SIZE_T StripeCount,
+    _In_reads_(PAGE_HASH_LANES) const ULONG64* Keys)
+{
+    SIZE_T          stripe;
+
+#if defined(PAGE_HASH_SSE2)
+    const __m128i   prime = _mm_set1_epi32((int)PRIME32_1);
+    __m128i         acc[PAGE_HASH_LANES / 2];
+    __m128i         key[PAGE_HASH_LANES / 2];
+    __m128i         v;
+    __m128i         k;
+    int             j;
+
+    for (j = 0; j < PAGE_HASH_LANES / 2; j++)
+    {
+        acc[j] = _mm_loadu_si128((const __m128i*)(Acc + 2 * j));
+        key[j] = _mm_loadu_si128((const __m128i*)(Keys + 2 * j));
+    }
+
+    for (stripe = 0; stripe < StripeCount; stripe++, Data += PAGE_HASH_STRIPE_SIZE)
+    {
+        for (j = 0; j < PAGE_HASH_LANES / 2; j++)
+        {
+            v = _mm_loadu_si128((const __m128i*)(Data + 16 * j));
+            k = _mm_xor_si128(v, key[j]);
+            acc[j] = _mm_add_epi64(acc[j], _mm_mul_epu32(k, _mm_shuffle_epi32(k, _MM_SHUFFLE(0, 3, 0, 1))));
+            acc[j] = _mm_add_epi64(acc[j], _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2)));
+        }
+
+        if (((stripe + 1) % PAGE_HASH_STRIPES_PER_BLOCK) == 0)
+        {
+            for (j = 0; j < PAGE_HASH_LANES / 2; j++)
+            {
+                v = _mm_xor_si128(acc[j], _mm_srli_epi64(acc[j], 47));
+                v = _mm_xor_si128(v, key[j]);
+                acc[j] = _mm_add_epi64(_mm_mul_epu32(v, prime),
+                                       _mm_slli_epi64(_mm_mul_epu32(_mm_srli_epi64(v, 32), prime), 32));
+            }
+        }
+    }
+
+    for (j = 0; j < PAGE_HASH_LANES / 2; j++)
+    {
+        _mm_storeu_si128((__m128i*)(Acc + 2 * j), acc[j]);
+    }
+
+#elif defined(PAGE_HASH_NEON)
+    const uint32x2_t prime = vdup_n_u32(PRIME32_1);
+    uint64x2_t      acc[PAGE_HASH_LANES / 2];
+    uint64x2_t      key[PAGE_HASH_LANES / 2];
+    uint64x2_t      v;
+    uint64x2_t      k;
+    int             j;
+
+    for (j = 0; j < PAGE_HASH_LANES / 2; j++)
+    {
+        acc[j] = vld1q_u64((const uint64_t*)(Acc + 2 * j));
+        key[j] = vld1q_u64((const uint64_t*)(Keys + 2 * j));
+    }
+
+    for (stripe = 0; stripe < StripeCount; stripe++, Data += PAGE_HASH_STRIPE_SIZE)
+    {
+        for (j = 0; j < PAGE_HASH_LANES / 2; j++)
+        {
+            v = vreinterpretq_u64_u8(vld1q_u8(Data + 16 * j));
+            k = veorq_u64(v, key[j]);
+            acc[j] = vmlal_u32(acc[j], vmovn_u64(k), vshrn_n_u64(k, 32));
+            acc[j] = vaddq_u64(acc[j], vextq_u64(v, v, 1));
+        }
+
+        if (((stripe + 1) % PAGE_HASH_STRIPES_PER_BLOCK) == 0)
+        {
+            for (j = 0; j < PAGE_HASH_LANES / 2; j++)
+            {
+                v = veorq_u64(acc[j], vshrq_n_u64(acc[j], 47));
+                v = veorq_u64(v, key[j]);
+                acc[j] = vaddq_u64(vmull_u32(vmovn_u64(v), prime),
+                                   vshlq_n_u64(vmull_u32(vshrn_n_u64(v, 32), prime), 32));
+            }
+        }
+    }
+
+    for (j = 0; j < PAGE_HASH_LANES / 2; j++)
+    {
+        vst1q_u64((uint64_t*)(Acc + 2 * j), acc[j]);
+    }
+
+#else
+    ULONG64         v;
+    ULONG64         k;
+    int             j;
+
+    for (stripe = 0; stripe < StripeCount; stripe++, Data += PAGE_HASH_STRIPE_SIZE)
+    {
+        for (j = 0; j < PAGE_HASH_LANES; j++)
+        {
+            memcpy(&v, Data + j * sizeof(ULONG64), sizeof(ULONG64));
+            k = v ^ Keys[j];
+            Acc[j ^ 1] += v;
+            Acc[j] += (k & 0xFFFFFFFF) * (k >> 32);
+        }
+
+        if (((stripe + 1) % PAGE_HASH_STRIPES_PER_BLOCK) == 0)
+        {
+            for (j = 0; j < PAGE_HASH_LANES; j++)
+            {
+                Acc[j] = ((Acc[j] ^ (Acc[j] >> 47)) ^ Keys[j]) * PRIME32_1;
+            }
+        }
+    }
+#endif
+}
+
+
+/****************************************************************************************
+**  ULONG64 PageHash64(Data, Length, Seed)
+**    A partial stripe at the end is padded with zeros, the length is mixed
+**    in when the lanes are merged.
+*****************************************************************************************/
+ULONG64
+PageHash64(
+    _In_reads_bytes_(Length) const VOID* Data,
+    _In_ SIZE_T Length,
+    _In_ ULONG64 Seed)
+{
+    ULONG64     acc[PAGE_HASH_LANES] = { PRIME32_3, PRIME64_1, PRIME64_2, PRIME64_3,
+                                         PRIME64_4, PRIME32_2, PRIME64_5, PRIME32_1 };
+    ULONG64     keys[PAGE_HASH_LANES];
+    UCHAR       tail[PAGE_HASH_STRIPE_SIZE];
+    SIZE_T      stripes = Length / PAGE_HASH_STRIPE_SIZE;
+    ULONG64     hash;
+    int         j;
+
+    for (j = 0; j < PAGE_HASH_LANES; j++)
+    {
+        keys[j] = PageHashSecret[j] + Seed;
+    }
+
+    PageHashStripes(acc, (const UCHAR*)Data, stripes, keys);
+
+    if ((Length % PAGE_HASH_STRIPE_SIZE) != 0)
+    {
+        memset(tail, 0, sizeof(tail));
+        memcpy(tail, (const UCHAR*)Data + stripes * PAGE_HASH_STRIPE_SIZE, Length % PAGE_HASH_STRIPE_SIZE);
+        PageHashStripes(acc, tail, 1, keys);
+    }
+
+    hash = ((ULONG64)Length * PRIME64_1) ^ Seed;
+    for (j = 0; j < PAGE_HASH_LANES; j++)
+    {
+        hash ^= _rotl64(acc[j] * PRIME64_2, 31) * PRIME64_1;
+        hash = _rotl64(hash, 27) * PRIME64_1 + PRIME64_4;
+    }
+
+    hash ^= hash >> 33;
+    hash *= PRIME64_2;
+    hash ^= hash >> 29;
+    hash *= PRIME64_3;
+    hash ^= hash >> 32;
+
+    return hash;
+}
+
+
+/****************************************************************************************
+**  VOID PageHashPages(Data, PageCount, Hashes, Seed)
+*****************************************************************************************/
+VOID
+PageHashPages(
+    _In_reads_bytes_(PageCount * PAGE_HASH_PAGE_SIZE) const VOID* Data,
+    _In_ SIZE_T PageCount,
+    _Out_writes_(PageCount) PULONG64 Hashes,
+    _In_ ULONG64 Seed)
+{
+    const UCHAR*    page = (const UCHAR*)Data;
+    SIZE_T          index;
+
+    for (index = 0; index < PageCount; index++, page += PAGE_HASH_PAGE_SIZE)
+    {
+        Hashes[index] = PageHash64(page, PAGE_HASH_PAGE_SIZE, Seed);
+    }
+}
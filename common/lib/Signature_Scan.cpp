@@ -0,0 +1,613 @@
+/*++
+
+    Copyright (C) Microsoft. All rights reserved.
+
+Module Name:
+   Signature_Scan.cpp
+
+Environment:
+   User Mode
+
+--*/
+#include <windows.h>
+#include <string.h>
+
+#if defined(_M_IX86) || defined(_M_X64)
+#include <emmintrin.h>
+#define SIGNATURE_SCAN_SSE2
+#elif defined(_M_ARM64)
+#include <arm64_neon.h>
+#define SIGNATURE_SCAN_NEON
+#endif
+
+#include "Signature_Scan.h"
+
+#define SIMD_WIDTH      16
+
+
+/****************************************************************************************
+**  BOOL MatchAt(Buffer, Pattern, PatternSize)
+**    Full compare of a candidate whose first and last bytes already match.
+*****************************************************************************************/
+static
+__forceinline
+BOOL
+MatchAt(
+    _In_ const UCHAR* Candidate,
+    _In_ const UCHAR* Pattern,
+    _In_ SIZE_T PatternSize)
+{
+    return (PatternSize <= 2) || (memcmp(Candidate + 1, Pattern + 1, PatternSize - 2) == 0);
+}
+
+
+/****************************************************************************************
+**  SIZE_T ScanScalar(...)
+**    Every offset from Start on: memchr for the first byte, then the last byte,
+**    then the rest.
+*****************************************************************************************/
+static
+SIZE_T
+ScanScalar(
+    _In_ const UCHAR* Buffer,
+    _In_ SIZE_T BufferSize,
+    _In_ SIZE_T Start,
+    _In_ const UCHAR* Pattern,
+    _In_ SIZE_T PatternSize,
+    _Inout_ PULONGLONG Candidates)
+{
+    SIZE_T          last = BufferSize - PatternSize;
+    const UCHAR*    hit;
+
+    while (Start <= last)
+    {
+        hit = (const UCHAR*)memchr(Buffer + Start, Pattern[0], last - Start + 1);
+        if (hit == nullptr)
+        {
+            break;
+        }
+
+        Start = (SIZE_T)(hit - Buffer);
+        if (hit[PatternSize - 1] == Pattern[PatternSize - 1])
+        {
+            (*Candidates)++;
+            if (MatchAt(hit, Pattern, PatternSize))
+            {
+                return Start;
+            }
+        }
+
+        Start++;
+    }
+
+    return SIGNATURE_NOT_FOUND;
+}
+
+
+/****************************************************************************************
+**  SIZE_T ScanVector(...)
+**    Every offset: compare sixteen first bytes and the sixteen matching last
+**    bytes at once, verify the offsets where both match. The tail that does
+**    not fill a vector goes to ScanScalar.
+*****************************************************************************************/
+static
+SIZE_T
+ScanVector(
+    _In_ const UCHAR* Buffer,
+    _In_ SIZE_T BufferSize,
+    _In_ const UCHAR* Pattern,
+    _In_ SIZE_T PatternSize,
+    _Inout_ PULONGLONG Candidates)
+{
+    SIZE_T  offset = 0;
+
+#if defined(SIGNATURE_SCAN_SSE2)
+    const __m128i   first = _mm_set1_epi8((char)Pattern[0]);
+    const __m128i   last = _mm_set1_epi8((char)Pattern[PatternSize - 1]);
+    unsigned long   bit;
+    int             mask;
+
+    for (; offset + SIMD_WIDTH + PatternSize - 1 <= BufferSize; offset += SIMD_WIDTH)
+    {
+        __m128i blockFirst = _mm_loadu_si128((const __m128i*)(Buffer + offset));
+        __m128i blockLast = _mm_loadu_si128((const __m128i*)(Buffer + offset + PatternSize - 1));
+
+        mask = _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(blockFirst, first),
+                                               _mm_cmpeq_epi8(blockLast, last)));
+        while (mask != 0)
+        {
+            _BitScanForward(&bit, (unsigned long)mask);
+            (*Candidates)++;
+            if (MatchAt(Buffer + offset + bit, Pattern, PatternSize))
+            {
+                return offset + bit;
+            }
+
+            mask &= mask - 1;
+        }
+    }
+#elif defined(SIGNATURE_SCAN_NEON)
+    const uint8x16_t    first = vdupq_n_u8(Pattern[0]);
+    const uint8x16_t    last = vdupq_n_u8(Pattern[PatternSize - 1]);
+    UCHAR               lanes[SIMD_WIDTH];
+    SIZE_T              lane;
+
+    for (; offset + SIMD_WIDTH + PatternSize - 1 <= BufferSize; offset += SIMD_WIDTH)
+    {
+        uint8x16_t match = vandq_u8(vceqq_u8(vld1q_u8(Buffer + offset), first),
+                                    vceqq_u8(vld1q_u8(Buffer + offset + PatternSize - 1), last));
+        if (vmaxvq_u8(match) == 0)
+        {
+            continue;
+        }
+
+        vst1q_u8(lanes, match);
+        for (lane = 0; lane < SIMD_WIDTH; lane++)
+        {
+            if (lanes[lane] != 0)
+            {
+                (*Candidates)++;
+                if (MatchAt(Buffer + offset + lane, Pattern, PatternSize))
+                {
+                    return offset + lane;
+                }
+            }
+        }
+    }
+#endif
+
+    return ScanScalar(Buffer, BufferSize, offset, Pattern, PatternSize, Candidates);
+}
+
+
+/****************************************************************************************
+**  SIZE_T ScanAligned(...)
+**    Only the offsets on the Alignment boundary given by Phase.
+*****************************************************************************************/
+static
+SIZE_T
+ScanAligned(
+    _In_ const UCHAR* Buffer,
+    _In_ SIZE_T BufferSize,
+    _In_ const UCHAR* Pattern,
+    _In_ SIZE_T PatternSize,
+    _In_ SIZE_T Alignment,
+    _In_ SIZE_T Phase,
+    _Inout_ PULONGLONG Candidates)
+{
+    SIZE_T  offset = (Alignment - (Phase % Alignment)) % Alignment;
+
+    for (; offset + PatternSize <= BufferSize; offset += Alignment)
+    {
+        if ((Buffer[offset] == Pattern[0]) && (Buffer[offset + PatternSize - 1] == Pattern[PatternSize - 1]))
+        {
+            (*Candidates)++;
+            if (MatchAt(Buffer + offset, Pattern, PatternSize))
+            {
+                return offset;
+            }
+        }
+    }
+
+    return SIGNATURE_NOT_FOUND;
+}
+
+
+SIZE_T
+SignatureScanFind(
+    _In_reads_bytes_(BufferSize) const UCHAR* Buffer,
+    _In_ SIZE_T BufferSize,
+    _In_reads_bytes_(PatternSize) const UCHAR* Pattern,
+    _In_ SIZE_T PatternSize,
+    _In_ SIZE_T Alignment,
+    _In_ SIZE_T Phase,
+    _Inout_opt_ PSIGNATURE_SCAN_STATS Stats)
+{
+    SIZE_T          found = SIGNATURE_NOT_FOUND;
+    ULONGLONG       candidates = 0;
+    LARGE_INTEGER   start;
+    LARGE_INTEGER   end;
+
+    if ((Buffer == nullptr) || (Pattern == nullptr) || (PatternSize == 0) || (BufferSize < PatternSize))
+    {
+        return SIGNATURE_NOT_FOUND;
+    }
+
+    QueryPerformanceCounter(&start);
+
+    if (Alignment > 1)
+    {
+        found = ScanAligned(Buffer, BufferSize, Pattern, PatternSize, Alignment, Phase, &candidates);
+    }
+    else
+    {
+        found = ScanVector(Buffer, BufferSize, Pattern, PatternSize, &candidates);
+    }
+
+    QueryPerformanceCounter(&end);
+
+    if (Stats != nullptr)
+    {
+        Stats->BytesScanned += (found == SIGNATURE_NOT_FOUND) ? BufferSize : found + PatternSize;
+        Stats->Candidates += candidates;
+        Stats->Ticks += (ULONGLONG)(end.QuadPart - start.QuadPart);
+    }
+
+    return found;
+}
+
+
+double
+SignatureScanGBps(_In_ PSIGNATURE_SCAN_STATS Stats)
+{
+    LARGE_INTEGER   frequency;
+
+    QueryPerformanceFrequency(&frequency);
+    if (Stats->Ticks == 0)
+    {
+        return 0.0;
+    }
+
+    return ((double)Stats->BytesScanned / (1024.0 * 1024.0 * 1024.0)) /
+           ((double)Stats->Ticks / (double)frequency.QuadPart);
+}
+
+
+VOID
+SignatureScannerInit(_Out_ PSIGNATURE_SCANNER Scanner)
+{
+    ZeroMemory(Scanner, sizeof(*Scanner));
+}
+
+
+HRESULT
+SignatureScannerAddPattern(
+    _Inout_ PSIGNATURE_SCANNER Scanner,
+    _In_ ULONG Id,
+    _In_reads_bytes_(Size) const UCHAR* Bytes,
+    _In_ SIZE_T Size,
+    _In_ SIZE_T Alignment,
+    _In_ ULONG MaxHits)
+{
+    PSIGNATURE_PATTERN  pattern;
+
+    if ((Bytes == nullptr) || (Size == 0) || (Size > SIGNATURE_SCANNER_MAX_PATTERN_SIZE))
+    {
+        return E_INVALIDARG;
+    }
+
+    if (Scanner->PatternCount == SIGNATURE_SCANNER_MAX_PATTERNS)
+    {
+        return HRESULT_FROM_WIN32(ERROR_INSUFFICIENT_BUFFER);
+    }
+
+    pattern = &Scanner->Patterns[Scanner->PatternCount++];
+    pattern->Id = Id;
+    pattern->Bytes = Bytes;
+    pattern->Size = Size;
+    pattern->Alignment = (Alignment > 1) ? Alignment : SIGNATURE_SCAN_ANY_OFFSET;
+    pattern->MaxHits = MaxHits;
+    pattern->HitCount = 0;
+
+    if (Size > Scanner->MaxPatternSize)
+    {
+        Scanner->MaxPatternSize = Size;
+    }
+
+    return S_OK;
+}
+
+
+VOID
+SignatureScannerSetFilter(
+    _Inout_ PSIGNATURE_SCANNER Scanner,
+    _In_opt_ PSIGNATURE_HIT_FILTER Filter,
+    _In_opt_ PVOID FilterContext)
+{
+    Scanner->Filter = Filter;
+    Scanner->FilterContext = FilterContext;
+}
+
+
+/****************************************************************************************
+**  VOID RecordHit(Scanner, Pattern, Offset)
+**    Adds a hit to the table unless the signature has all it asked for or
+**    the filter rejects it.
+*****************************************************************************************/
+static
+VOID
+RecordHit(
+    _Inout_ PSIGNATURE_SCANNER Scanner,
+    _Inout_ PSIGNATURE_PATTERN Pattern,
+    _In_ ULONGLONG Offset)
+{
+    if ((Pattern->MaxHits != 0) && (Pattern->HitCount >= Pattern->MaxHits))
+    {
+        return;
+    }
+
+    if ((Scanner->Filter != nullptr) && !Scanner->Filter(Scanner->FilterContext, Pattern->Id, Offset))
+    {
+        return;
+    }
+
+    if (Scanner->HitCount == SIGNATURE_SCANNER_MAX_HITS)
+    {
+        Scanner->DroppedHits++;
+        return;
+    }
+
+    Scanner->Hits[Scanner->HitCount].Id = Pattern->Id;
+    Scanner->Hits[Scanner->HitCount].Offset = Offset;
+    Scanner->HitCount++;
+    Pattern->HitCount++;
+}
+
+
+/****************************************************************************************
+**  VOID CheckCandidate(...)
+**    Verifies a candidate of one signature and records it if it starts
+**    before StartLimit and ends after EndMin.
+*****************************************************************************************/
+static
+__forceinline
+VOID
+CheckCandidate(
+    _Inout_ PSIGNATURE_SCANNER Scanner,
+    _Inout_ PSIGNATURE_PATTERN Pattern,
+    _In_ const UCHAR* Block,
+    _In_ SIZE_T Offset,
+    _In_ ULONGLONG BaseOffset,
+    _In_ SIZE_T StartLimit,
+    _In_ SIZE_T EndMin)
+{
+    Scanner->Stats.Candidates++;
+    if ((Offset < StartLimit) &&
+        (Offset + Pattern->Size > EndMin) &&
+        MatchAt(Block + Offset, Pattern->Bytes, Pattern->Size))
+    {
+        RecordHit(Scanner, Pattern, BaseOffset + Offset);
+    }
+}
+
+
+/****************************************************************************************
+**  VOID ScanBlock(...)
+**    One pass over Block for every signature. Aligned signatures are checked
+**    at their boundaries only. The others are filtered sixteen offsets at a
+**    time on their first and last bytes; the tail that does not fill a vector
+**    is searched byte by byte.
+*****************************************************************************************/
+static
+VOID
+ScanBlock(
+    _Inout_ PSIGNATURE_SCANNER Scanner,
+    _In_ const UCHAR* Block,
+    _In_ SIZE_T BlockSize,
+    _In_ ULONGLONG BaseOffset,
+    _In_ SIZE_T StartLimit,
+    _In_ SIZE_T EndMin)
+{
+    PSIGNATURE_PATTERN  pattern;
+    SIZE_T              offset;
+    SIZE_T              vectorEnd = 0;
+    SIZE_T              unalignedMax = 0;
+    ULONG               index;
+
+    for (index = 0; index < Scanner->PatternCount; index++)
+    {
+        pattern = &Scanner->Patterns[index];
+        if (pattern->Size > BlockSize)
+        {
+            continue;
+        }
+
+        if (pattern->Alignment != SIGNATURE_SCAN_ANY_OFFSET)
+        {
+            offset = (SIZE_T)((pattern->Alignment - (BaseOffset % pattern->Alignment)) % pattern->Alignment);
+            for (; offset + pattern->Size <= BlockSize; offset += pattern->Alignment)
+            {
+                if ((Block[offset] == pattern->Bytes[0]) &&
+                    (Block[offset + pattern->Size - 1] == pattern->Bytes[pattern->Size - 1]))
+                {
+                    CheckCandidate(Scanner, pattern, Block, offset, BaseOffset, StartLimit, EndMin);
+                }
+            }
+        }
+        else if (pattern->Size > unalignedMax)
+        {
+            unalignedMax = pattern->Size;
+        }
+    }
+
+    if (unalignedMax == 0)
+    {
+        return;
+    }
+
+#if defined(SIGNATURE_SCAN_SSE2) || defined(SIGNATURE_SCAN_NEON)
+    for (; vectorEnd + SIMD_WIDTH + unalignedMax - 1 <= BlockSize; vectorEnd += SIMD_WIDTH)
+    {
+        for (index = 0; index < Scanner->PatternCount; index++)
+        {
+            pattern = &Scanner->Patterns[index];
+            if (pattern->Alignment != SIGNATURE_SCAN_ANY_OFFSET)
+            {
+                continue;
+            }
+
+#if defined(SIGNATURE_SCAN_SSE2)
+            unsigned long   bit;
+            int             mask;
+
+            mask = _mm_movemask_epi8(_mm_and_si128(
+                       _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(Block + vectorEnd)),
+                                      _mm_set1_epi8((char)pattern->Bytes[0])),
+                       _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(Block + vectorEnd + pattern->Size - 1)),
+                                      _mm_set1_epi8((char)pattern->Bytes[pattern->Size - 1]))));
+            while (mask != 0)
+            {
+                _BitScanForward(&bit, (unsigned long)mask);
+                CheckCandidate(Scanner, pattern, Block, vectorEnd + bit, BaseOffset, StartLimit, EndMin);
+                mask &= mask - 1;
+            }
+#else
+            UCHAR       lanes[SIMD_WIDTH];
+            SIZE_T      lane;
+            uint8x16_t  match;
+
+            match = vandq_u8(vceqq_u8(vld1q_u8(Block + vectorEnd), vdupq_n_u8(pattern->Bytes[0])),
+                             vceqq_u8(vld1q_u8(Block + vectorEnd + pattern->Size - 1),
+                                      vdupq_n_u8(pattern->Bytes[pattern->Size - 1])));
+            if (vmaxvq_u8(match) == 0)
+            {
+                continue;
+            }
+
+            vst1q_u8(lanes, match);
+            for (lane = 0; lane < SIMD_WIDTH; lane++)
+            {
+                if (lanes[lane] != 0)
+                {
+                    CheckCandidate(Scanner, pattern, Block, vectorEnd + lane, BaseOffset, StartLimit, EndMin);
+                }
+            }
+#endif
+        }
+    }
+#endif
+
+    for (index = 0; index < Scanner->PatternCount; index++)
+    {
+        pattern = &Scanner->Patterns[index];
+        if ((pattern->Alignment != SIGNATURE_SCAN_ANY_OFFSET) || (pattern->Size > BlockSize))
+        {
+            continue;
+        }
+
+        for (offset = vectorEnd; offset + pattern->Size <= BlockSize; offset++)
+        {
+            if ((Block[offset] == pattern->Bytes[0]) &&
+                (Block[offset + pattern->Size - 1] == pattern->Bytes[pattern->Size - 1]))
+            {
+                CheckCandidate(Scanner, pattern, Block, offset, BaseOffset, StartLimit, EndMin);
+            }
+        }
+    }
+}
+
+
+VOID
+SignatureScannerScan(
+    _Inout_ PSIGNATURE_SCANNER Scanner,
+    _In_reads_bytes_(BufferSize) const UCHAR* Buffer,
+    _In_ SIZE_T BufferSize,
+    _In_ ULONGLONG BaseOffset)
+{
+    UCHAR           junction[SIGNATURE_SCANNER_MAX_PATTERN_SIZE * 3];
+    SIZE_T          head;
+    SIZE_T          keep;
+    SIZE_T          carried;
+    LARGE_INTEGER   start;
+    LARGE_INTEGER   end;
+
+    if ((Buffer == nullptr) || (BufferSize == 0) || (Scanner->PatternCount == 0))
+    {
+        return;
+    }
+
+    QueryPerformanceCounter(&start);
+
+    if ((Scanner->CarrySize == 0) || (BaseOffset != Scanner->StreamEnd))
+    {
+        Scanner->CarrySize = 0;
+    }
+    else
+    {
+        //
+        // Signatures that start in the tail of the previous buffer and end
+        // in this one. Those that fit in the tail were found already.
+        //
+        head = min(BufferSize, Scanner->MaxPatternSize - 1);
+        memcpy(junction, Scanner->Carry, Scanner->CarrySize);
+        memcpy(junction + Scanner->CarrySize, Buffer, head);
+        ScanBlock(Scanner,
+                  junction,
+                  Scanner->CarrySize + head,
+                  BaseOffset - Scanner->CarrySize,
+                  Scanner->CarrySize,
+                  Scanner->CarrySize);
+    }
+
+    ScanBlock(Scanner, Buffer, BufferSize, BaseOffset, BufferSize, 0);
+
+    //
+    // Keep the last MaxPatternSize - 1 bytes of the stream for the next call.
+    //
+    keep = Scanner->MaxPatternSize - 1;
+    if (BufferSize >= keep)
+    {
+        memcpy(Scanner->Carry, Buffer + BufferSize - keep, keep);
+        Scanner->CarrySize = keep;
+    }
+    else
+    {
+        carried = min(Scanner->CarrySize, keep - BufferSize);
+        memmove(Scanner->Carry, Scanner->Carry + Scanner->CarrySize - carried, carried);
+        memcpy(Scanner->Carry + carried, Buffer, BufferSize);
+        Scanner->CarrySize = carried + BufferSize;
+    }
+
+    Scanner->StreamEnd = BaseOffset + BufferSize;
+
+    QueryPerformanceCounter(&end);
+    Scanner->Stats.BytesScanned += BufferSize;
+    Scanner->Stats.Ticks += (ULONGLONG)(end.QuadPart - start.QuadPart);
+}
+
+
+VOID
+SignatureScannerEndStream(_Inout_ PSIGNATURE_SCANNER Scanner)
+{
+    Scanner->CarrySize = 0;
+}
+
+
+_Ret_maybenull_
+const SIGNATURE_HIT*
+SignatureScannerFirstHit(
+    _In_ PSIGNATURE_SCANNER Scanner,
+    _In_ ULONG Id)
+{
+    const SIGNATURE_HIT*    first = nullptr;
+    ULONG                   index;
+
+    for (index = 0; index < Scanner->HitCount; index++)
+    {
+        if ((Scanner->Hits[index].Id == Id) &&
+            ((first == nullptr) || (Scanner->Hits[index].Offset < first->Offset)))
+        {
+            first = &Scanner->Hits[index];
+        }
+    }
+
+    return first;
+}
+
+
+BOOL
+SignatureScannerComplete(_In_ PSIGNATURE_SCANNER Scanner)
+{
+    ULONG   index;
+
+    for (index = 0; index < Scanner->PatternCount; index++)
+    {
+        if ((Scanner->Patterns[index].MaxHits == 0) ||
+            (Scanner->Patterns[index].HitCount < Scanner->Patterns[index].MaxHits))
+        {
+            return FALSE;
+        }
+    }
+
+    return TRUE;
+}
@@ -1,20 +1,20 @@
-/*++
-
-    Copyright (C) Microsoft. All rights reserved.
-
-Module Name:
-   DisplayFuncs.h
-
-Environment:
-   User Mode
-
-Author:
-   José Pagán (jopagan)
---*/
-
-#pragma once
-
-#include <stdio.h>
-#include <DEVICE_IO.h>
-
-void    DisplayResults01(DEVICE_IO* pIn);
+/*++
+
+    Copyright (C) Microsoft. All rights reserved.
+
+Module Name:
+   DisplayFuncs.h
+
+Environment:
+   User Mode
+
+Author:
+   José Pagán (jopagan)
+--*/
+
+#pragma once
+
+#include <stdio.h>
+#include <DEVICE_IO.h>
+
+void    DisplayResults01(DEVICE_IO* pIn);
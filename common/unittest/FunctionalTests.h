@@ -1,52 +1,81 @@
-/*++
-
-    Copyright (C) Microsoft. All rights reserved.
-
-Module Name:
-   FunctionalTests.h
-
-Environment:
-   User Mode
-
-Author:
-   José Pagán (jopagan)
---*/
-
-#pragma once
-
-#include <stdio.h>
-#include <DEVICE_IO.h>
-#include <RawDumpDefs.h>
-#include <Device_Specific.h>
-#include <DisplayFuncs.h>
-
-#define TEST_PATTERN_BEGIN      32       // <space>
-#define TEST_PATTERN_END        126      // Last Ascii Char
-#define TEST_PATTERN_SIZE       (TEST_PATTERN_END - TEST_PATTERN_BEGIN + 1)
-#define OFFSET2VALUE(offset)    (CHAR)( ((offset) % TEST_PATTERN_SIZE) + TEST_PATTERN_BEGIN )
-#define TEST_FILLER_SIZE        1024    // Size of Device Specific filler
-
-// DEVICE_IO class tests
-UINT Test_Unopened(DEVICE_IO *pIn, wstring devName, UINT devID );
-UINT Test_Open_File(DEVICE_IO *pIn, wstring devName, UINT devID);
-UINT Test_Open_Device(DEVICE_IO *pIn, wstring devName, UINT devID);
-UINT Test_Open_Partition_File(DEVICE_IO *pIn, wstring devName, UINT devID);
-UINT Test_Open_Partition_Device(DEVICE_IO *pIn, wstring devName, UINT devID);
-UINT Test_Open_Partition_Position(DEVICE_IO *pIn, wstring devName, UINT devID);
-UINT Test_Open_Partition_Position_Read_Headers(DEVICE_IO *pIn, wstring devName, UINT devID, ULONG bufSize);
-UINT Test_Open_Partition_Position_Read_Chunks (DEVICE_IO *pIn, wstring devName, UINT devID, ULONG bufSize);
-UINT Test_Open_Partition_Position_Read_Write_Chunk (DEVICE_IO *pIn, wstring devName, UINT devID, ULONG bufSize);
-
-// Device Specific data structure tests
-UINT Test_Device_Specific(DEVICE_IO *pIn, wstring devName, UINT devID);
-
-// // // // // Helpers // // // // //
-// DEVICE_IO class helpers
-UINT ResultPartitionedDevice(DEVICE_IO *pIn, wstring devName, UINT devID);
-BOOL ValidateBuffer(PCHAR buff, ULONG buffSize, ULONGLONG readOffset);
-BOOL TEST_SetPos_Func(DEVICE_IO * pIn, ULONGLONG newPos);
-BOOL TEST_Read_Func(DEVICE_IO * pIn, PCHAR buff, UINT buffSize);
-BOOL TEST_Write_Func (DEVICE_IO * pIn, PCHAR buff, UINT buffSize);
-
-// Device Specific data structure helpers
-UINT Test_Write_Read_Device_Specific(DEVICE_IO *pIn);
+/*++
+
+    Copyright (C) Microsoft. All rights reserved.
+
+Module Name:
+   FunctionalTests.h
+
+Environment:
+   User Mode
+
+Author:
+   José Pagán (jopagan)
+--*/
+
+#pragma once
+
+#include <stdio.h>
+#include <DEVICE_IO.h>
+#include <RawDumpDefs.h>
+#include <Device_Specific.h>
+#include <DisplayFuncs.h>
+#include <Memory_Budget.h>
+#include <Signature_Scan.h>
+#include <Kd_Decode.h>
+#include <Page_Hash.h>
+#include <Dump_Magic.h>
+
+#define TEST_PATTERN_BEGIN      32       // <space>
+#define TEST_PATTERN_END        126      // Last Ascii Char
+#define TEST_PATTERN_SIZE       (TEST_PATTERN_END - TEST_PATTERN_BEGIN + 1)
+#define OFFSET2VALUE(offset)    (CHAR)( ((offset) % TEST_PATTERN_SIZE) + TEST_PATTERN_BEGIN )
+#define TEST_FILLER_SIZE        1024    // Size of Device Specific filler
+#define TEST_BUDGET_CEILING     0x100000    // Memory budget ceiling for the test
+#define TEST_BUDGET_MINIMUM     0x10000     // Smallest adaptive allocation
+#define TEST_SCAN_BUFFER_SIZE   0x10000     // Buffer searched by the signature scan test
+#define TEST_KD_BLOCK_SIZE      0x352       // Odd sized block decoded by the KdDebuggerDataBlock test
+#define TEST_MULTI_FILE_SIZE0   0x1234      // First file of the multi file device test
+#define TEST_MULTI_FILE_SIZE1   0x2000      // Second file of the multi file device test
+#define TEST_MULTI_FILE_SPLIT   12          // Bytes of the dump header signature in the first file
+#define TEST_MULTI_FILE_CHUNK   0x1000      // Read size of the multi file device scan
+#define TEST_HASH_PAGES         2           // Pages hashed by the page hash test
+
+// DEVICE_IO class tests
+UINT Test_Unopened(DEVICE_IO *pIn, wstring devName, UINT devID );
+UINT Test_Open_File(DEVICE_IO *pIn, wstring devName, UINT devID);
+UINT Test_Open_Device(DEVICE_IO *pIn, wstring devName, UINT devID);
+UINT Test_Open_Partition_File(DEVICE_IO *pIn, wstring devName, UINT devID);
+UINT Test_Open_Partition_Device(DEVICE_IO *pIn, wstring devName, UINT devID);
+UINT Test_Open_Partition_Position(DEVICE_IO *pIn, wstring devName, UINT devID);
+UINT Test_Open_Partition_Position_Read_Headers(DEVICE_IO *pIn, wstring devName, UINT devID, ULONG bufSize);
+UINT Test_Open_Partition_Position_Read_Chunks (DEVICE_IO *pIn, wstring devName, UINT devID, ULONG bufSize);
+UINT Test_Open_Partition_Position_Read_Write_Chunk (DEVICE_IO *pIn, wstring devName, UINT devID, ULONG bufSize);
+
+// Device Specific data structure tests
+UINT Test_Device_Specific(DEVICE_IO *pIn, wstring devName, UINT devID);
+
+// Memory budget tests
+UINT Test_Memory_Budget();
+
+// Signature scan tests
+UINT Test_Signature_Scan();
+
+// KdDebuggerDataBlock decode tests
+UINT Test_Kd_Decode();
+
+// Multi file device tests
+UINT Test_Multi_File();
+
+// Page hash tests
+UINT Test_Page_Hash();
+
+// // // // // Helpers // // // // //
+// DEVICE_IO class helpers
+UINT ResultPartitionedDevice(DEVICE_IO *pIn, wstring devName, UINT devID);
+BOOL ValidateBuffer(PCHAR buff, ULONG buffSize, ULONGLONG readOffset);
+BOOL TEST_SetPos_Func(DEVICE_IO * pIn, ULONGLONG newPos);
+BOOL TEST_Read_Func(DEVICE_IO * pIn, PCHAR buff, UINT buffSize);
+BOOL TEST_Write_Func (DEVICE_IO * pIn, PCHAR buff, UINT buffSize);
+
+// Device Specific data structure helpers
+UINT Test_Write_Read_Device_Specific(DEVICE_IO *pIn);
@@ -0,0 +1,431 @@
+/*++
+
+Copyright (c) Microsoft Corporation, All Rights Reserved
+
+Module Name:
+    RawDumpIndex.cpp
+
+Abstract:
+    Sidecar index of a raw dump file. The first conversion of a raw dump
+    writes what it found out next to it, later conversions of the same raw
+    dump map the index and skip the DDR memory map build, the search of the
+    DDR sections for the DUMP_HEADER and the KdDebuggerDataBlock translation.
+
+Environment:
+    User Mode
+
+--*/
+#include "dumputil.h"
+
+
+static
+BOOL
+GetRawDumpIndexName(
+    _In_ PDMP_CONTEXT Context,
+    _Out_ wstring& IndexName
+    )
+/*++
+
+Routine Description:
+
+    Only raw dumps in plain files have an index, partitions are read as is.
+
+--*/
+{
+    IndexName.clear();
+
+    if ((Context->RawFile == nullptr) ||
+        (Context->RawFile->GetDeviceType() != DEVICE_IO::PLAIN_FILE_DEVICE_TYPE) ||
+        Context->RawFile->GetDeviceName().empty()) {
+        return FALSE;
+    }
+
+    IndexName = Context->RawFile->GetDeviceName() + RAW_DUMP_INDEX_EXTENSION;
+    return TRUE;
+}
+
+
+static
+UINT32
+GetRawDumpHeaderCrc32(
+    _In_ PDMP_CONTEXT Context
+    )
+{
+    UINT32 crc32;
+
+    crc32 = RtlComputeCrc32(0, &Context->RawDumpHeader, sizeof(Context->RawDumpHeader));
+    crc32 = RtlComputeCrc32(crc32,
+                            Context->RawDumpSectionTable,
+                            (ULONG)RawDumpTableSize(Context->RawDumpHeader.SectionsCount));
+
+    return crc32;
+}
+
+
+static
+UINT64
+GetDirectoryTableBase(
+    _In_ PDMP_CONTEXT Context
+    )
+{
+    if (Context->Is64Bit && (Context->DumpHeader64 != nullptr)) {
+        return (UINT64)Context->DumpHeader64->DirectoryTableBase;
+    }
+
+    if (!Context->Is64Bit && (Context->DumpHeader32 != nullptr)) {
+        return (UINT64)Context->DumpHeader32->DirectoryTableBase;
+    }
+
+    return 0;
+}
+
+
+BOOL
+LoadRawDumpIndex(
+    _Inout_ PDMP_CONTEXT Context
+    )
+/*++
+
+Routine Description:
+
+    Maps the sidecar index of the raw dump and, if it was written for this
+    raw dump, takes the DDR memory map and the DUMP_HEADER address from it.
+    The raw dump header and section table must have been read and verified.
+    An index that does not match is ignored, it is rewritten once the
+    conversion succeeds.
+
+Arguments:
+
+    Context - Pointer to DmpContext
+
+Return Value:
+
+    TRUE if the index was loaded, Context->RawDumpIndexLoaded is set too.
+
+--*/
+{
+    HANDLE                  file = INVALID_HANDLE_VALUE;
+    HANDLE                  mapping = nullptr;
+    PUCHAR                  view = nullptr;
+    PRAW_DUMP_INDEX_HEADER  header;
+    PRAW_DUMP_INDEX_RANGE   ranges;
+    PDDR_MEMORY_MAP         memoryMap = nullptr;
+    LARGE_INTEGER           fileSize;
+    wstring                 indexName;
+    UINT64                  totalSize = 0;
+    UINT32                  holes = 0;
+    UINT32                  index;
+
+    Context->RawDumpIndexLoaded = FALSE;
+
+    if (!GetRawDumpIndexName(Context, indexName) ||
+        (Context->RawDumpSectionTable == nullptr) ||
+        (Context->DDRSectionCount == 0)) {
+        goto Exit;
+    }
+
+    file = CreateFileW(indexName.c_str(),
+                       GENERIC_READ,
+                       FILE_SHARE_READ | FILE_SHARE_DELETE,
+                       nullptr,
+                       OPEN_EXISTING,
+                       FILE_ATTRIBUTE_NORMAL,
+                       nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        TraceInfo("No index for this raw dump");
+        goto Exit;
+    }
+
+    if (!GetFileSizeEx(file, &fileSize) ||
+        ((UINT64)fileSize.QuadPart != RawDumpIndexSize(Context->RawDumpHeader.SectionsCount, Context->DDRSectionCount))) {
+        TraceInfo1("Raw dump index has the wrong size", "Size", fileSize.QuadPart);
+        goto Exit;
+    }
+
+    mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping == nullptr) {
+        TraceInfo1("Unable to map the raw dump index", "Error", GetLastError());
+        goto Exit;
+    }
+
+    view = (PUCHAR)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (view == nullptr) {
+        TraceInfo1("Unable to map a view of the raw dump index", "Error", GetLastError());
+        goto Exit;
+    }
+
+    //
+    // Check the key first, then that the index is whole.
+    //
+    header = (PRAW_DUMP_INDEX_HEADER)view;
+    if ((header->Signature != RAW_DUMP_INDEX_SIGNATURE) ||
+        (header->Version != RAW_DUMP_INDEX_VERSION) ||
+        (header->HeaderSize != sizeof(RAW_DUMP_INDEX_HEADER)) ||
+        (header->SectionCount != Context->RawDumpHeader.SectionsCount) ||
+        (header->DDRRangeCount != Context->DDRSectionCount)) {
+        TraceInfo("Raw dump index has an unknown format");
+        goto Exit;
+    }
+
+    if ((header->RawDumpSize != (UINT64)Context->RawDumpFileLength.QuadPart) ||
+        (header->RawDumpHeaderCrc32 != GetRawDumpHeaderCrc32(Context))) {
+        TraceInfo("Raw dump index was written for another raw dump");
+        goto Exit;
+    }
+
+    if ((header->Crc32 != RtlComputeCrc32(0, view + sizeof(*header), (ULONG)(fileSize.QuadPart - sizeof(*header)))) ||
+        (memcmp(view + sizeof(*header), Context->RawDumpSectionTable, RawDumpTableSize(header->SectionCount)) != 0)) {
+        TraceInfo("Raw dump index is corrupted");
+        goto Exit;
+    }
+
+    memoryMap = (PDDR_MEMORY_MAP)HeapAlloc(GetProcessHeap(), HEAP_ZERO_MEMORY, sizeof(DDR_MEMORY_MAP) * header->DDRRangeCount);
+    if (memoryMap == nullptr) {
+        TraceInfo("Failed to allocate memory for DDR memory map");
+        goto Exit;
+    }
+
+    //
+    // The ranges were sorted and checked by BuildDDRMemoryMap when the index
+    // was written, only the fields it derives are filled in again.
+    //
+    ranges = (PRAW_DUMP_INDEX_RANGE)(view + sizeof(*header) + RawDumpTableSize(header->SectionCount));
+    for (index = 0; index < header->DDRRangeCount; index++) {
+        if ((ranges[index].Size == 0) ||
+            ((index > 0) && (ranges[index].Base <= memoryMap[index - 1].End))) {
+            TraceInfo1("Raw dump index has a bad DDR range", "Index", index);
+            goto Exit;
+        }
+
+        memoryMap[index].Base = ranges[index].Base;
+        memoryMap[index].Size = ranges[index].Size;
+        memoryMap[index].Offset = ranges[index].Offset;
+        memoryMap[index].End = ranges[index].Base + ranges[index].Size - 1;
+        memoryMap[index].Contiguous = (index == 0) || (memoryMap[index - 1].End + 1 == memoryMap[index].Base);
+        if (!memoryMap[index].Contiguous) {
+            holes++;
+        }
+
+        totalSize += ranges[index].Size;
+    }
+
+    Context->DDRMemoryMap = memoryMap;
+    Context->DDRMemoryMapCount = header->DDRRangeCount;
+    Context->TotalDDRSizeInBytes = totalSize;
+    Context->DDRSectionFragmentationCount = holes;
+    memoryMap = nullptr;
+
+    if (Context->DumpHeaderPA.QuadPart == 0) {
+        Context->DumpHeaderPA.QuadPart = (LONGLONG)header->DumpHeaderPA;
+    }
+
+    memcpy(&Context->RawDumpIndex, header, sizeof(Context->RawDumpIndex));
+    Context->RawDumpIndexLoaded = TRUE;
+    TraceInfo1("Loaded the raw dump index", "PA", header->DumpHeaderPA);
+
+Exit:
+    if (memoryMap != nullptr) {
+        HeapFree(GetProcessHeap(), NULL, memoryMap);
+    }
+
+    if (view != nullptr) {
+        UnmapViewOfFile(view);
+    }
+
+    if (mapping != nullptr) {
+        CloseHandle(mapping);
+    }
+
+    if (file != INVALID_HANDLE_VALUE) {
+        CloseHandle(file);
+    }
+
+    return Context->RawDumpIndexLoaded;
+}
+
+
+VOID
+SaveRawDumpIndex(
+    _In_ PDMP_CONTEXT Context
+    )
+/*++
+
+Routine Description:
+
+    Writes the sidecar index of the raw dump after a successful conversion,
+    unless the index that was loaded already says the same. The index is
+    written to a temporary file first and renamed, so that a reader never
+    sees half of it. Failures are only traced, the index is an optimization.
+
+Arguments:
+
+    Context - Pointer to DmpContext
+
+Return Value:
+
+    None.
+
+--*/
+{
+    HANDLE                  file = INVALID_HANDLE_VALUE;
+    PUCHAR                  buffer = nullptr;
+    PRAW_DUMP_INDEX_HEADER  header;
+    PRAW_DUMP_INDEX_RANGE   ranges;
+    wstring                 indexName;
+    wstring                 tempName;
+    SIZE_T                  indexSize;
+    DWORD                   bytesWritten = 0;
+    UINT32                  index;
+
+    if (!GetRawDumpIndexName(Context, indexName) ||
+        (Context->RawDumpSectionTable == nullptr) ||
+        (Context->DDRMemoryMap == nullptr) ||
+        (Context->DDRMemoryMapCount == 0)) {
+        goto Exit;
+    }
+
+    indexSize = RawDumpIndexSize(Context->RawDumpHeader.SectionsCount, Context->DDRMemoryMapCount);
+    buffer = (PUCHAR)HeapAlloc(GetProcessHeap(), HEAP_ZERO_MEMORY, indexSize);
+    if (buffer == nullptr) {
+        TraceInfo("Failed to allocate memory for the raw dump index");
+        goto Exit;
+    }
+
+    header = (PRAW_DUMP_INDEX_HEADER)buffer;
+    header->Signature = RAW_DUMP_INDEX_SIGNATURE;
+    header->Version = RAW_DUMP_INDEX_VERSION;
+    header->HeaderSize = sizeof(RAW_DUMP_INDEX_HEADER);
+    header->RawDumpSize = (UINT64)Context->RawDumpFileLength.QuadPart;
+    header->RawDumpHeaderCrc32 = GetRawDumpHeaderCrc32(Context);
+    header->SectionCount = Context->RawDumpHeader.SectionsCount;
+    header->DDRRangeCount = Context->DDRMemoryMapCount;
+    header->Is64Bit = Context->Is64Bit;
+    header->APRegPA = (UINT64)Context->APRegAddress.QuadPart;
+
+    if (Context->DumpHeaderStatus == DHS_VALID) {
+        header->DumpHeaderPA = (UINT64)Context->DumpHeaderPA.QuadPart;
+        header->DirectoryTableBase = GetDirectoryTableBase(Context);
+    }
+
+    if ((Context->KdDebuggerDataBlock != nullptr) &&
+        ((UINT64)Context->KdDebuggerDataBlockPA.QuadPart != ADDRESS_NOT_PRESENT)) {
+        header->KdDebuggerDataBlockPA = (UINT64)Context->KdDebuggerDataBlockPA.QuadPart;
+    }
+
+    memcpy(buffer + sizeof(*header), Context->RawDumpSectionTable, RawDumpTableSize(header->SectionCount));
+
+    ranges = (PRAW_DUMP_INDEX_RANGE)(buffer + sizeof(*header) + RawDumpTableSize(header->SectionCount));
+    for (index = 0; index < header->DDRRangeCount; index++) {
+        ranges[index].Base = Context->DDRMemoryMap[index].Base;
+        ranges[index].Size = Context->DDRMemoryMap[index].Size;
+        ranges[index].Offset = Context->DDRMemoryMap[index].Offset;
+    }
+
+    header->Crc32 = RtlComputeCrc32(0, buffer + sizeof(*header), (ULONG)(indexSize - sizeof(*header)));
+
+    if (Context->RawDumpIndexLoaded &&
+        (memcmp(&Context->RawDumpIndex, header, sizeof(*header)) == 0)) {
+        goto Exit;
+    }
+
+    tempName = indexName + L".tmp";
+    file = CreateFileW(tempName.c_str(),
+                       GENERIC_WRITE,
+                       0,
+                       nullptr,
+                       CREATE_ALWAYS,
+                       FILE_ATTRIBUTE_NORMAL,
+                       nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        TraceInfo1("Unable to create the raw dump index", "Error", GetLastError());
+        goto Exit;
+    }
+
+    if (!WriteFile(file, buffer, (DWORD)indexSize, &bytesWritten, nullptr) ||
+        (bytesWritten != indexSize)) {
+        TraceInfo1("Unable to write the raw dump index", "Error", GetLastError());
+        CloseHandle(file);
+        file = INVALID_HANDLE_VALUE;
+        DeleteFileW(tempName.c_str());
+        goto Exit;
+    }
+
+    CloseHandle(file);
+    file = INVALID_HANDLE_VALUE;
+
+    if (!MoveFileExW(tempName.c_str(), indexName.c_str(), MOVEFILE_REPLACE_EXISTING)) {
+        TraceInfo1("Unable to rename the raw dump index", "Error", GetLastError());
+        DeleteFileW(tempName.c_str());
+        goto Exit;
+    }
+
+    TraceInfo1("Wrote the raw dump index", "Size", indexSize);
+
+Exit:
+    if (file != INVALID_HANDLE_VALUE) {
+        CloseHandle(file);
+    }
+
+    if (buffer != nullptr) {
+        HeapFree(GetProcessHeap(), NULL, buffer);
+    }
+}
+
+
+NTSTATUS
+GetKdDBlockFromRawDumpIndex(
+    _Inout_ PDMP_CONTEXT        Context,
+    _Out_   PKDDEBUGGER_DATA64  pdbgDataBlock,
+    _Out_   PLARGE_INTEGER      pdbgDataHeaderPA
+    )
+/*++
+
+Routine Description:
+
+    Reads the KdDebuggerDataBlock at the physical address the index has for
+    it. The address is only used with the page tables it was translated
+    with, and the block read there must be valid and decoded.
+
+Arguments:
+
+    Context - Pointer to DmpContext
+
+    pdbgDataBlock - Receives the KdDebuggerDataBlock
+
+    pdbgDataHeaderPA - Receives its physical address
+
+Return Value:
+
+    NT status code.
+
+--*/
+{
+    NTSTATUS status = STATUS_NOT_FOUND;
+
+    if (!Context->RawDumpIndexLoaded ||
+        (Context->RawDumpIndex.KdDebuggerDataBlockPA == 0) ||
+        (Context->RawDumpIndex.DirectoryTableBase != GetDirectoryTableBase(Context))) {
+        goto Exit;
+    }
+
+    pdbgDataHeaderPA->QuadPart = (LONGLONG)Context->RawDumpIndex.KdDebuggerDataBlockPA;
+    status = ReadFromDDRSectionByPhysicalAddress(Context,
+                                                 *pdbgDataHeaderPA,
+                                                 sizeof(KDDEBUGGER_DATA64),
+                                                 pdbgDataBlock);
+    if (!NT_SUCCESS(status)) {
+        TraceNTSTATUS("Failed to read the KdDebuggerDataBlock from the indexed PA", status);
+        goto Exit;
+    }
+
+    if ((pdbgDataBlock->Header.Size > MAX_KDDEBUGGER_BLOCK_SIZE) ||
+        !ValidateKdDebuggerDataBlock(&(pdbgDataBlock->Header))) {
+        status = STATUS_UNSUCCESSFUL;
+        goto Exit;
+    }
+
+    TraceInfo1("Read KdDebuggerDataBlock at the indexed", "PA", pdbgDataHeaderPA->QuadPart);
+
+Exit:
+    return status;
+}
@@ -1,11 +1,18 @@
-#pragma once
-
-namespace Raw2Dump
-{
-    bool ConvertRawToDump(
-        _In_ LPWSTR rawDumpPath, 
-        _In_ LPWSTR rawInfoFile, 
-        _In_ LPWSTR logFile,
-        _In_ LPWSTR windowsDumpFile);
-}
-
+#pragma once
+
+#include "Raw2Dump_State.h"
+
+namespace Raw2Dump
+{
+    bool ConvertRawToDump(
+        _In_ LPWSTR rawDumpPath, 
+        _In_ LPWSTR rawInfoFile, 
+        _In_ LPWSTR logFile,
+        _In_ LPWSTR windowsDumpFile);
+
+    HRESULT ConvertRawStateToDump(
+        _In_ PRAW2DUMP_STATE rawDumpState,
+        _In_opt_ LPWSTR logFile,
+        _In_ LPWSTR windowsDumpFile);
+}
+
@@ -0,0 +1,524 @@
+/*++
+
+    Copyright (C) Microsoft. All rights reserved.
+
+Module Name:
+   Diff.cpp
+
+Abstract:
+   Page by page comparison of two raw dumps of the same device, for instance
+   after repeated watchdog resets. The DDR ranges of both raw dumps are lined
+   up by physical address, every page both of them hold is hashed with
+   PageHash64 on a pool of threads, and the pages whose hashes differ are
+   reported as ranges. Optionally the differing pages of the second raw dump
+   are written to a delta file.
+
+   Delta file layout: a DIFF_DELTA_HEADER, then RunCount times a
+   DIFF_DELTA_RUN followed by its PageCount pages.
+
+Environment:
+   User Mode
+
+--*/
+#include "common.h"
+#include "DumpUtil.h"
+#include "Page_Hash.h"
+#include <vector>
+
+#define DIFF_CHUNK_PAGES            1024
+#define DIFF_CHUNK_SIZE             (DIFF_CHUNK_PAGES * PAGE_SIZE)
+#define DIFF_MAX_THREADS            16
+
+#define DIFF_DELTA_SIGNATURE        0x544C4444      // "DDLT"
+#define DIFF_DELTA_VERSION          1
+
+#define ALIGN_UP_TO_PAGE(x)         (((x) + PAGE_SIZE - 1) & ~((UINT64)PAGE_SIZE - 1))
+#define ALIGN_DOWN_TO_PAGE(x)       ((x) & ~((UINT64)PAGE_SIZE - 1))
+
+typedef struct _DIFF_DELTA_HEADER
+{
+    UINT32      Signature;
+    UINT32      Version;
+    UINT32      HeaderSize;
+    UINT32      PageSize;
+    UINT64      RunCount;
+    UINT64      PageCount;
+} DIFF_DELTA_HEADER, *PDIFF_DELTA_HEADER;
+
+typedef struct _DIFF_DELTA_RUN
+{
+    UINT64      Base;
+    UINT64      PageCount;
+} DIFF_DELTA_RUN, *PDIFF_DELTA_RUN;
+
+//
+// Physical pages held by both raw dumps, with where they are in each.
+//
+typedef struct _DIFF_EXTENT
+{
+    UINT64      Base;
+    UINT64      PageCount;
+    UINT64      Offset[2];
+    UINT64      FirstPage;
+} DIFF_EXTENT, *PDIFF_EXTENT;
+
+typedef struct _DIFF_CHUNK
+{
+    UINT32      Extent;
+    UINT64      Page;
+    UINT32      PageCount;
+} DIFF_CHUNK, *PDIFF_CHUNK;
+
+typedef struct _DIFF_POOL
+{
+    PDMP_CONTEXT                Contexts[2];
+    std::vector<DIFF_EXTENT>    Extents;
+    std::vector<DIFF_CHUNK>     Chunks;
+    UINT64                      PageCount;
+    PBOOLEAN                    Changed;
+    volatile LONG               NextChunk;
+    volatile LONG               Status;
+} DIFF_POOL, *PDIFF_POOL;
+
+
+static
+HRESULT
+OpenDiffRawDump(
+    _Inout_ PDMP_CONTEXT Context,
+    _In_ LPCWSTR FileName
+    )
+{
+    BOOL        valid = FALSE;
+    HRESULT     hr;
+
+    if (FAILED(hr = Context->hDisk.Open(FileName))) {
+        LogLibErrorPrintf(hr, __LINE__, WIDEN(__FUNCTION__), __WFILE__, L"Error: Failed to open raw dump %s\n", FileName);
+        goto Exit;
+    }
+
+    if (FAILED(hr = VerifyRawDumpHeader(Context, &valid)) || !valid ||
+        FAILED(hr = VerifyRawDumpSectionTable(Context, &valid)) || !valid) {
+        hr = FAILED(hr) ? hr : E_FAIL;
+        LogLibErrorPrintf(hr, __LINE__, WIDEN(__FUNCTION__), __WFILE__, L"Error: %s is not a valid raw dump\n", FileName);
+        goto Exit;
+    }
+
+    if (!NT_SUCCESS(BuildDDRMemoryMap(Context))) {
+        hr = E_FAIL;
+        LogLibErrorPrintf(hr, __LINE__, WIDEN(__FUNCTION__), __WFILE__, L"Error: Failed to build the DDR memory map of %s\n", FileName);
+        goto Exit;
+    }
+
+    hr = S_OK;
+
+Exit:
+    return hr;
+}
+
+
+static
+VOID
+BuildDiffExtents(
+    _Inout_ PDIFF_POOL Pool
+    )
+/*++
+
+Routine Description:
+
+    Lines up the sorted DDR memory maps of the two raw dumps and keeps the
+    whole pages both of them hold, then cuts them into chunks for the
+    workers.
+
+--*/
+{
+    PDDR_MEMORY_MAP first = Pool->Contexts[0]->DDRMemoryMap;
+    PDDR_MEMORY_MAP second = Pool->Contexts[1]->DDRMemoryMap;
+    UINT32          firstCount = Pool->Contexts[0]->DDRMemoryMapCount;
+    UINT32          secondCount = Pool->Contexts[1]->DDRMemoryMapCount;
+    UINT32          i = 0;
+    UINT32          j = 0;
+    UINT64          start;
+    UINT64          end;
+    UINT64          page;
+    DIFF_EXTENT     extent;
+    DIFF_CHUNK      chunk;
+
+    Pool->PageCount = 0;
+    while ((i < firstCount) && (j < secondCount)) {
+        start = ALIGN_UP_TO_PAGE(max(first[i].Base, second[j].Base));
+        end = ALIGN_DOWN_TO_PAGE(min(first[i].End, second[j].End) + 1);
+        if (end > start) {
+            extent.Base = start;
+            extent.PageCount = (end - start) / PAGE_SIZE;
+            extent.Offset[0] = first[i].Offset + (start - first[i].Base);
+            extent.Offset[1] = second[j].Offset + (start - second[j].Base);
+            extent.FirstPage = Pool->PageCount;
+            Pool->Extents.push_back(extent);
+            Pool->PageCount += extent.PageCount;
+        }
+
+        if (first[i].End <= second[j].End) {
+            i++;
+        }
+        else {
+            j++;
+        }
+    }
+
+    for (chunk.Extent = 0; chunk.Extent < (UINT32)Pool->Extents.size(); chunk.Extent++) {
+        for (page = 0; page < Pool->Extents[chunk.Extent].PageCount; page += DIFF_CHUNK_PAGES) {
+            chunk.Page = page;
+            chunk.PageCount = (UINT32)min(Pool->Extents[chunk.Extent].PageCount - page, (UINT64)DIFF_CHUNK_PAGES);
+            Pool->Chunks.push_back(chunk);
+        }
+    }
+}
+
+
+static
+DWORD
+WINAPI
+DiffWorker(
+    _In_ LPVOID Parameter
+    )
+/*++
+
+Routine Description:
+
+    Hashes chunks of both raw dumps until none is left or another worker
+    failed. Each worker opens the raw dumps again, so that the reads do not
+    share a file position.
+
+--*/
+{
+    PDIFF_POOL      pool = (PDIFF_POOL)Parameter;
+    DEVICE_IO       rawFiles[2];
+    PUCHAR          buffers[2] = { };
+    ULONG64         hashes[2][DIFF_CHUNK_PAGES];
+    PDIFF_EXTENT    extent;
+    PDIFF_CHUNK     chunk;
+    LARGE_INTEGER   offset;
+    LONG            chunkIndex;
+    UINT32          index;
+    UINT32          page;
+    HRESULT         hr = S_OK;
+
+    for (index = 0; index < 2; index++) {
+        buffers[index] = (PUCHAR)HeapAlloc(GetProcessHeap(), 0, DIFF_CHUNK_SIZE);
+        if (nullptr == buffers[index]) {
+            hr = E_OUTOFMEMORY;
+            LogLibInfoPrintf(L"Could not allocate memory for diff buffer %ld", DIFF_CHUNK_SIZE);
+            goto Exit;
+        }
+
+        if (FAILED(hr = rawFiles[index].Open(pool->Contexts[index]->hDisk.GetDeviceName()))) {
+            LogLibInfoPrintf(L"Failed to open the raw dump for a diff thread. HRESULT: 0x%x", hr);
+            goto Exit;
+        }
+    }
+
+    for (;;) {
+        chunkIndex = InterlockedIncrement(&pool->NextChunk) - 1;
+        if ((pool->Status != S_OK) || (chunkIndex >= (LONG)pool->Chunks.size())) {
+            break;
+        }
+
+        chunk = &pool->Chunks[chunkIndex];
+        extent = &pool->Extents[chunk->Extent];
+        for (index = 0; index < 2; index++) {
+            offset.QuadPart = (LONGLONG)(extent->Offset[index] + chunk->Page * PAGE_SIZE);
+            if (FAILED(hr = rawFiles[index].ReadAtOffset((PCHAR)buffers[index], chunk->PageCount * PAGE_SIZE, offset, DEVICE_IO::READ_EXACT))) {
+                LogLibInfoPrintf(L"Failed to read raw dump at 0x%llx. HRESULT: 0x%x", offset.QuadPart, hr);
+                goto Exit;
+            }
+
+            PageHashPages(buffers[index], chunk->PageCount, hashes[index], 0);
+        }
+
+        for (page = 0; page < chunk->PageCount; page++) {
+            pool->Changed[extent->FirstPage + chunk->Page + page] = (hashes[0][page] != hashes[1][page]);
+        }
+    }
+
+    hr = S_OK;
+
+Exit:
+    if (FAILED(hr)) {
+        InterlockedCompareExchange(&pool->Status, hr, S_OK);
+    }
+
+    for (index = 0; index < 2; index++) {
+        if (nullptr != buffers[index]) {
+            HeapFree(GetProcessHeap(), 0, buffers[index]);
+        }
+    }
+
+    return 0;
+}
+
+
+static
+HRESULT
+WriteDiffDelta(
+    _In_ PDIFF_POOL Pool,
+    _In_ const std::vector<DIFF_DELTA_RUN>& Runs,
+    _In_ UINT64 ChangedPages,
+    _In_ LPCWSTR FileName
+    )
+/*++
+
+Routine Description:
+
+    Writes the changed pages of the second raw dump to the delta file.
+
+--*/
+{
+    HANDLE              file = INVALID_HANDLE_VALUE;
+    PUCHAR              buffer = nullptr;
+    DIFF_DELTA_HEADER   header = { 0 };
+    LARGE_INTEGER       offset;
+    PDIFF_EXTENT        extent;
+    UINT64              page;
+    UINT64              pages;
+    UINT32              extentIndex = 0;
+    DWORD               bytesWritten;
+    HRESULT             hr = S_OK;
+
+    buffer = (PUCHAR)HeapAlloc(GetProcessHeap(), 0, DIFF_CHUNK_SIZE);
+    if (nullptr == buffer) {
+        hr = E_OUTOFMEMORY;
+        goto Exit;
+    }
+
+    file = CreateFileW(FileName, GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        hr = HRESULT_FROM_WIN32(GetLastError());
+        LogLibErrorPrintf(hr, __LINE__, WIDEN(__FUNCTION__), __WFILE__, L"Error: Failed to create delta file %s\n", FileName);
+        goto Exit;
+    }
+
+    header.Signature = DIFF_DELTA_SIGNATURE;
+    header.Version = DIFF_DELTA_VERSION;
+    header.HeaderSize = sizeof(header);
+    header.PageSize = PAGE_SIZE;
+    header.RunCount = Runs.size();
+    header.PageCount = ChangedPages;
+    if (!WriteFile(file, &header, sizeof(header), &bytesWritten, nullptr) || (bytesWritten != sizeof(header))) {
+        hr = HRESULT_FROM_WIN32(GetLastError());
+        goto Exit;
+    }
+
+    //
+    // The runs are in address order and never cross an extent.
+    //
+    for (const DIFF_DELTA_RUN& run : Runs) {
+        if (!WriteFile(file, &run, sizeof(run), &bytesWritten, nullptr) || (bytesWritten != sizeof(run))) {
+            hr = HRESULT_FROM_WIN32(GetLastError());
+            goto Exit;
+        }
+
+        while ((Pool->Extents[extentIndex].Base + Pool->Extents[extentIndex].PageCount * PAGE_SIZE) <= run.Base) {
+            extentIndex++;
+        }
+
+        extent = &Pool->Extents[extentIndex];
+        for (page = 0; page < run.PageCount; page += pages) {
+            pages = min(run.PageCount - page, (UINT64)DIFF_CHUNK_PAGES);
+            offset.QuadPart = (LONGLONG)(extent->Offset[1] + (run.Base - extent->Base) + page * PAGE_SIZE);
+            if (FAILED(hr = Pool->Contexts[1]->hDisk.ReadAtOffset((PCHAR)buffer, (ULONG)(pages * PAGE_SIZE), offset, DEVICE_IO::READ_EXACT))) {
+                LogLibInfoPrintf(L"Failed to read raw dump at 0x%llx. HRESULT: 0x%x", offset.QuadPart, hr);
+                goto Exit;
+            }
+
+            if (!WriteFile(file, buffer, (DWORD)(pages * PAGE_SIZE), &bytesWritten, nullptr) || (bytesWritten != pages * PAGE_SIZE)) {
+                hr = HRESULT_FROM_WIN32(GetLastError());
+                goto Exit;
+            }
+        }
+    }
+
+Exit:
+    if (FAILED(hr)) {
+        LogLibErrorPrintf(hr, __LINE__, WIDEN(__FUNCTION__), __WFILE__, L"Error: Failed to write delta file %s\n", FileName);
+    }
+
+    if (file != INVALID_HANDLE_VALUE) {
+        CloseHandle(file);
+    }
+
+    if (nullptr != buffer) {
+        HeapFree(GetProcessHeap(), 0, buffer);
+    }
+
+    return hr;
+}
+
+
+HRESULT
+DiffRawDumps(
+    _In_ LPCWSTR FirstFileName,
+    _In_ LPCWSTR SecondFileName,
+    _In_opt_ LPCWSTR DeltaFileName,
+    _In_ UINT32 Jobs
+    )
+/*++
+
+Routine Description:
+
+    Compares two raw dumps page by page and prints the physical ranges that
+    differ. Pages held by only one of the raw dumps are counted, not
+    compared.
+
+Arguments:
+
+    FirstFileName - First raw dump
+
+    SecondFileName - Second raw dump
+
+    DeltaFileName - Optional file that receives the changed pages of the
+                    second raw dump
+
+    Jobs - Number of threads, 0 for one per processor
+
+Return Value:
+
+    HRESULT
+
+--*/
+{
+    DMP_CONTEXT                     contexts[2] = { };
+    LPCWSTR                         fileNames[2] = { FirstFileName, SecondFileName };
+    DIFF_POOL                       pool;
+    std::vector<DIFF_DELTA_RUN>     runs;
+    DIFF_DELTA_RUN                  run = { 0 };
+    HANDLE                          threads[DIFF_MAX_THREADS] = { };
+    UINT32                          threadCount = 0;
+    UINT64                          changedPages = 0;
+    UINT64                          index;
+    UINT64                          totalBytes;
+    UINT32                          extentIndex;
+    UINT32                          dump;
+    LARGE_INTEGER                   frequency;
+    LARGE_INTEGER                   start;
+    LARGE_INTEGER                   end;
+    ULONGLONG                       elapsedMs;
+    SYSTEM_INFO                     sysInfo;
+    HRESULT                         hr = S_OK;
+
+    pool.Changed = nullptr;
+    pool.NextChunk = 0;
+    pool.Status = S_OK;
+
+    for (dump = 0; dump < 2; dump++) {
+        contexts[dump].DedicatedDumpHandle = INVALID_HANDLE_VALUE;
+        pool.Contexts[dump] = &contexts[dump];
+        if (FAILED(hr = OpenDiffRawDump(&contexts[dump], fileNames[dump]))) {
+            goto Exit;
+        }
+    }
+
+    BuildDiffExtents(&pool);
+    if (pool.PageCount == 0) {
+        wprintf(L"The raw dumps have no physical pages in common\n");
+        goto Exit;
+    }
+
+    pool.Changed = (PBOOLEAN)HeapAlloc(GetProcessHeap(), HEAP_ZERO_MEMORY, (SIZE_T)pool.PageCount);
+    if (nullptr == pool.Changed) {
+        hr = E_OUTOFMEMORY;
+        goto Exit;
+    }
+
+    if (Jobs == 0) {
+        GetSystemInfo(&sysInfo);
+        Jobs = sysInfo.dwNumberOfProcessors;
+    }
+
+    Jobs = min(min(Jobs, (UINT32)DIFF_MAX_THREADS), (UINT32)pool.Chunks.size());
+
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&start);
+    for (threadCount = 0; threadCount < Jobs; threadCount++) {
+        threads[threadCount] = CreateThread(nullptr, 0, DiffWorker, &pool, 0, nullptr);
+        if (nullptr == threads[threadCount]) {
+            break;
+        }
+    }
+
+    if (0 == threadCount) {
+        DiffWorker(&pool);
+    }
+    else {
+        WaitForMultipleObjects(threadCount, threads, TRUE, INFINITE);
+    }
+
+    QueryPerformanceCounter(&end);
+    if (FAILED(hr = (HRESULT)pool.Status)) {
+        LogLibErrorPrintf(hr, __LINE__, WIDEN(__FUNCTION__), __WFILE__, L"Error: Failed to hash the raw dumps\n");
+        goto Exit;
+    }
+
+    //
+    // Coalesce the changed pages into runs, a run ends at a changed page's
+    // unchanged neighbour or at the end of an extent.
+    //
+    for (extentIndex = 0; extentIndex < (UINT32)pool.Extents.size(); extentIndex++) {
+        const DIFF_EXTENT& extent = pool.Extents[extentIndex];
+
+        for (index = 0; index <= extent.PageCount; index++) {
+            if ((index < extent.PageCount) && pool.Changed[extent.FirstPage + index]) {
+                if (run.PageCount == 0) {
+                    run.Base = extent.Base + index * PAGE_SIZE;
+                }
+
+                run.PageCount++;
+                changedPages++;
+            }
+            else if (run.PageCount != 0) {
+                wprintf(L"Changed %016I64x - %016I64x (%I64u pages)\n",
+                        run.Base,
+                        run.Base + run.PageCount * PAGE_SIZE - 1,
+                        run.PageCount);
+                runs.push_back(run);
+                run.PageCount = 0;
+            }
+        }
+    }
+
+    elapsedMs = (ULONGLONG)((end.QuadPart - start.QuadPart) * 1000 / frequency.QuadPart);
+    totalBytes = pool.PageCount * PAGE_SIZE;
+    wprintf(L"%I64u pages in common: %I64u identical, %I64u changed in %Iu ranges\n",
+            pool.PageCount,
+            pool.PageCount - changedPages,
+            changedPages,
+            runs.size());
+    for (dump = 0; dump < 2; dump++) {
+        wprintf(L"%I64u MB only in %s\n",
+                (contexts[dump].SectionStats.TotalDDRSizeInBytes - totalBytes) / (1024 * 1024),
+                fileNames[dump]);
+    }
+
+    wprintf(L"Hashed 2 x %I64u MB in %I64u ms on %u threads\n",
+            totalBytes / (1024 * 1024),
+            elapsedMs,
+            max(threadCount, 1U));
+
+    if ((DeltaFileName != nullptr) && SUCCEEDED(hr = WriteDiffDelta(&pool, runs, changedPages, DeltaFileName))) {
+        wprintf(L"Wrote %I64u changed pages of %s to %s\n", changedPages, SecondFileName, DeltaFileName);
+    }
+
+Exit:
+    for (index = 0; index < threadCount; index++) {
+        CloseHandle(threads[index]);
+    }
+
+    if (nullptr != pool.Changed) {
+        HeapFree(GetProcessHeap(), 0, pool.Changed);
+    }
+
+    for (dump = 0; dump < 2; dump++) {
+        FreeDumpContext(&contexts[dump]);
+    }
+
+    return hr;
+}
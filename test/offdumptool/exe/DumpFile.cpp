@@ -0,0 +1,683 @@
+/*++
+
+    Copyright (C) Microsoft. All rights reserved.
+
+Module Name:
+   DumpFile.cpp
+
+Environment:
+   User Mode
+
+--*/
+#include "common.h"
+#include "DumpFile.h"
+
+template <typename HEADER>
+static
+HRESULT
+DumpFileReadRuns(
+    _Inout_ PDUMP_FILE DumpFile,
+    _In_ const HEADER* Header
+    )
+/*++
+
+Routine Description:
+
+    Builds the run table from the PhysicalMemoryBlock of a full dump header.
+    The pages of the runs follow the header in run order; the secondary data
+    follows the last page.
+
+Arguments:
+
+    DumpFile - The dump file being opened.
+
+    Header - The DUMP_HEADER32 or DUMP_HEADER64 at the start of the dump.
+
+Return Value:
+
+    HRESULT.
+
+--*/
+{
+    HRESULT     hr = S_OK;
+    ULONG64     fileOffset = sizeof(HEADER);
+    ULONG       maxRuns;
+    ULONG       index;
+
+    maxRuns = (ULONG)((sizeof(Header->PhysicalMemoryBlockBuffer) -
+                       ((const UCHAR*)&Header->PhysicalMemoryBlock.Run[0] - (const UCHAR*)&Header->PhysicalMemoryBlock)) /
+                      sizeof(Header->PhysicalMemoryBlock.Run[0]));
+
+    if (Header->DumpType != DUMP_TYPE_FULL) {
+        hr = HRESULT_FROM_WIN32(ERROR_NOT_SUPPORTED);
+        LogLibErrorPrintf(
+            hr,
+            __LINE__,
+            WIDEN(__FUNCTION__),
+            __WFILE__,
+            L" Only full dumps are supported. DumpType: 0x%x",
+            Header->DumpType);
+        goto Exit;
+    }
+
+    if ((Header->PhysicalMemoryBlock.NumberOfRuns == 0) || (Header->PhysicalMemoryBlock.NumberOfRuns > maxRuns)) {
+        hr = HRESULT_FROM_WIN32(ERROR_FILE_CORRUPT);
+        LogLibErrorPrintf(
+            hr,
+            __LINE__,
+            WIDEN(__FUNCTION__),
+            __WFILE__,
+            L" Invalid number of physical memory runs: %u",
+            Header->PhysicalMemoryBlock.NumberOfRuns);
+        goto Exit;
+    }
+
+    DumpFile->Runs = (PDUMP_FILE_RUN)calloc(Header->PhysicalMemoryBlock.NumberOfRuns, sizeof(DUMP_FILE_RUN));
+    if (DumpFile->Runs == NULL) {
+        hr = E_OUTOFMEMORY;
+        goto Exit;
+    }
+
+    for (index = 0; index < Header->PhysicalMemoryBlock.NumberOfRuns; index++) {
+        PDUMP_FILE_RUN run = &DumpFile->Runs[index];
+
+        run->BasePage = Header->PhysicalMemoryBlock.Run[index].BasePage;
+        run->PageCount = Header->PhysicalMemoryBlock.Run[index].PageCount;
+        run->FileOffset = fileOffset;
+
+        if ((run->PageCount > (DumpFile->FileSize / PAGE_SIZE)) ||
+            ((fileOffset + (run->PageCount * PAGE_SIZE)) > DumpFile->FileSize)) {
+            hr = HRESULT_FROM_WIN32(ERROR_FILE_CORRUPT);
+            LogLibErrorPrintf(
+                hr,
+                __LINE__,
+                WIDEN(__FUNCTION__),
+                __WFILE__,
+                L" Run %u (BasePage: 0x%I64x PageCount: 0x%I64x) is past the end of the dump file.",
+                index,
+                run->BasePage,
+                run->PageCount);
+            goto Exit;
+        }
+
+        fileOffset += run->PageCount * PAGE_SIZE;
+        DumpFile->RunCount++;
+    }
+
+    DumpFile->SecondaryDataOffset = fileOffset;
+
+    LogLibInfoPrintf(L"Dump file has %u runs, secondary data at 0x%I64x. SecondaryDataState: 0x%x\r\n",
+                     DumpFile->RunCount,
+                     DumpFile->SecondaryDataOffset,
+                     Header->SecondaryDataState);
+
+Exit:
+
+    return hr;
+}
+
+
+static
+HRESULT
+DumpFileReadBlobs(
+    _Inout_ PDUMP_FILE DumpFile
+    )
+/*++
+
+Routine Description:
+
+    Builds the blob table from the secondary data. The walk stops at the end
+    of the file or at the first blob header that is not one, e.g. the zeroes
+    of a dedicated dump file larger than the dump.
+
+Arguments:
+
+    DumpFile - The dump file being opened.
+
+Return Value:
+
+    HRESULT.
+
+--*/
+{
+    DUMP_BLOB_FILE_HEADER   fileHeader;
+    DUMP_BLOB_HEADER        blobHeader;
+    HRESULT                 hr = S_OK;
+    ULONG64                 offset = DumpFile->SecondaryDataOffset;
+    ULONG64                 dataOffset;
+    ULONG                   blobsAllocated = 0;
+    PDUMP_FILE_BLOB         blobs;
+
+    if ((offset + sizeof(fileHeader)) > DumpFile->FileSize) {
+        LogLibInfoPrintf(L"No secondary data in the dump file.\r\n");
+        goto Exit;
+    }
+
+    if (FAILED(hr = DumpFileRead(DumpFile, offset, &fileHeader, sizeof(fileHeader)))) {
+        goto Exit;
+    }
+
+    if ((fileHeader.Signature1 != DUMP_BLOB_SIGNATURE1) ||
+        (fileHeader.Signature2 != DUMP_BLOB_SIGNATURE2) ||
+        (fileHeader.HeaderSize < sizeof(fileHeader))) {
+        LogLibInfoPrintf(L"No secondary data blob file header at 0x%I64x.\r\n", offset);
+        goto Exit;
+    }
+
+    offset += fileHeader.HeaderSize;
+
+    while ((offset + sizeof(blobHeader)) <= DumpFile->FileSize) {
+        if (FAILED(hr = DumpFileRead(DumpFile, offset, &blobHeader, sizeof(blobHeader)))) {
+            goto Exit;
+        }
+
+        if (blobHeader.HeaderSize < sizeof(blobHeader)) {
+            break;
+        }
+
+        dataOffset = offset + blobHeader.HeaderSize + blobHeader.PrePad;
+        if ((dataOffset + blobHeader.DataSize) > DumpFile->FileSize) {
+            LogLibInfoPrintf(L"Secondary data blob at 0x%I64x is truncated. DataSize: 0x%x\r\n",
+                             offset,
+                             blobHeader.DataSize);
+            break;
+        }
+
+        if (DumpFile->BlobCount == blobsAllocated) {
+            blobsAllocated = (blobsAllocated == 0) ? 16 : (blobsAllocated * 2);
+            blobs = (PDUMP_FILE_BLOB)realloc(DumpFile->Blobs, blobsAllocated * sizeof(DUMP_FILE_BLOB));
+            if (blobs == NULL) {
+                hr = E_OUTOFMEMORY;
+                goto Exit;
+            }
+
+            DumpFile->Blobs = blobs;
+        }
+
+        DumpFile->Blobs[DumpFile->BlobCount].Tag = blobHeader.Tag;
+        DumpFile->Blobs[DumpFile->BlobCount].DataOffset = dataOffset;
+        DumpFile->Blobs[DumpFile->BlobCount].DataSize = blobHeader.DataSize;
+        DumpFile->BlobCount++;
+
+        offset = dataOffset + blobHeader.DataSize + blobHeader.PostPad;
+    }
+
+    LogLibInfoPrintf(L"Dump file has %u secondary data blobs.\r\n", DumpFile->BlobCount);
+
+Exit:
+
+    return hr;
+}
+
+
+HRESULT
+DumpFileOpen(
+    _In_ LPCWSTR FileName,
+    _Out_ PDUMP_FILE DumpFile
+    )
+/*++
+
+Routine Description:
+
+    Maps a full Windows dump file read only and reads its run table and the
+    table of its secondary data blobs.
+
+Arguments:
+
+    FileName - Path of the dump file.
+
+    DumpFile - Receives the opened dump file. DumpFileClose() must be called
+        on it, whether this succeeds or not.
+
+Return Value:
+
+    HRESULT.
+
+--*/
+{
+    HRESULT             hr = S_OK;
+    LARGE_INTEGER       fileSize;
+    SYSTEM_INFO         sysInfo;
+    const UCHAR*        header = NULL;
+    SIZE_T              mappedSize = 0;
+
+    ZeroMemory(DumpFile, sizeof(*DumpFile));
+    DumpFile->File = INVALID_HANDLE_VALUE;
+
+    GetSystemInfo(&sysInfo);
+    DumpFile->AllocationGranularity = sysInfo.dwAllocationGranularity;
+
+    DumpFile->File = CreateFileW(FileName,
+                                 GENERIC_READ,
+                                 FILE_SHARE_READ,
+                                 NULL,
+                                 OPEN_EXISTING,
+                                 FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+                                 NULL);
+    if (DumpFile->File == INVALID_HANDLE_VALUE) {
+        hr = HRESULT_FROM_WIN32(GetLastError());
+        LogLibErrorPrintf(
+            hr,
+            __LINE__,
+            WIDEN(__FUNCTION__),
+            __WFILE__,
+            L" Failed to open Dump file: %s",
+            FileName);
+        goto Exit;
+    }
+
+    if (!GetFileSizeEx(DumpFile->File, &fileSize)) {
+        hr = HRESULT_FROM_WIN32(GetLastError());
+        goto Exit;
+    }
+
+    DumpFile->FileSize = (ULONG64)fileSize.QuadPart;
+    if (DumpFile->FileSize < sizeof(DUMP_HEADER32)) {
+        hr = HRESULT_FROM_WIN32(ERROR_FILE_CORRUPT);
+        LogLibErrorPrintf(
+            hr,
+            __LINE__,
+            WIDEN(__FUNCTION__),
+            __WFILE__,
+            L" Dump file is too small: 0x%I64x bytes",
+            DumpFile->FileSize);
+        goto Exit;
+    }
+
+    DumpFile->Mapping = CreateFileMappingW(DumpFile->File, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (DumpFile->Mapping == NULL) {
+        hr = HRESULT_FROM_WIN32(GetLastError());
+        LogLibErrorPrintf(
+            hr,
+            __LINE__,
+            WIDEN(__FUNCTION__),
+            __WFILE__,
+            L" Failed to map Dump file: %s",
+            FileName);
+        goto Exit;
+    }
+
+    //
+    // The first view always holds the whole header.
+    //
+    if (FAILED(hr = DumpFileMap(DumpFile, 0, sizeof(DUMP_HEADER64), &header, &mappedSize))) {
+        goto Exit;
+    }
+
+    if (((const DUMP_HEADER32*)header)->Signature != DUMP_SIGNATURE32) {
+        hr = HRESULT_FROM_WIN32(ERROR_FILE_CORRUPT);
+        LogLibErrorPrintf(
+            hr,
+            __LINE__,
+            WIDEN(__FUNCTION__),
+            __WFILE__,
+            L" Invalid DUMP_HEADER.Signature: 0x%x",
+            ((const DUMP_HEADER32*)header)->Signature);
+        goto Exit;
+    }
+
+    if ((((const DUMP_HEADER64*)header)->ValidDump == DUMP_VALID_DUMP64) && (mappedSize >= sizeof(DUMP_HEADER64))) {
+        DumpFile->Is64Bit = TRUE;
+        hr = DumpFileReadRuns(DumpFile, (const DUMP_HEADER64*)header);
+    }
+    else if (((const DUMP_HEADER32*)header)->ValidDump == DUMP_VALID_DUMP32) {
+        DumpFile->Is64Bit = FALSE;
+        hr = DumpFileReadRuns(DumpFile, (const DUMP_HEADER32*)header);
+    }
+    else {
+        hr = HRESULT_FROM_WIN32(ERROR_FILE_CORRUPT);
+        LogLibErrorPrintf(
+            hr,
+            __LINE__,
+            WIDEN(__FUNCTION__),
+            __WFILE__,
+            L" Invalid DUMP_HEADER.ValidDump: 0x%x",
+            ((const DUMP_HEADER32*)header)->ValidDump);
+    }
+
+    if (FAILED(hr)) {
+        goto Exit;
+    }
+
+    hr = DumpFileReadBlobs(DumpFile);
+
+Exit:
+
+    return hr;
+}
+
+
+VOID
+DumpFileClose(
+    _Inout_ PDUMP_FILE DumpFile
+    )
+{
+    if (DumpFile->View != NULL) {
+        UnmapViewOfFile(DumpFile->View);
+        DumpFile->View = NULL;
+    }
+
+    if (DumpFile->Mapping != NULL) {
+        CloseHandle(DumpFile->Mapping);
+        DumpFile->Mapping = NULL;
+    }
+
+    if (DumpFile->File != INVALID_HANDLE_VALUE) {
+        CloseHandle(DumpFile->File);
+        DumpFile->File = INVALID_HANDLE_VALUE;
+    }
+
+    if (DumpFile->Runs != NULL) {
+        free(DumpFile->Runs);
+        DumpFile->Runs = NULL;
+    }
+
+    if (DumpFile->Blobs != NULL) {
+        free(DumpFile->Blobs);
+        DumpFile->Blobs = NULL;
+    }
+
+    DumpFile->RunCount = 0;
+    DumpFile->BlobCount = 0;
+}
+
+
+HRESULT
+DumpFileMap(
+    _Inout_ PDUMP_FILE DumpFile,
+    _In_ ULONG64 Offset,
+    _In_ ULONG64 Size,
+    _Outptr_result_bytebuffer_(*MappedSize) const UCHAR** Data,
+    _Out_ PSIZE_T MappedSize
+    )
+/*++
+
+Routine Description:
+
+    Returns a pointer to the data of the dump file at Offset. A new view is
+    mapped when Offset is not in the current one. Views are at most
+    DUMP_FILE_VIEW_SIZE bytes, so that less than Size bytes may be available;
+    the caller moves on to the next view by asking for the rest. The pointer
+    stays valid until the next call.
+
+Arguments:
+
+    DumpFile - The opened dump file.
+
+    Offset - Byte offset into the dump file.
+
+    Size - Number of bytes wanted.
+
+    Data - Receives the pointer to the data.
+
+    MappedSize - Receives the number of bytes available at Data, never more
+        than Size.
+
+Return Value:
+
+    HRESULT.
+
+--*/
+{
+    HRESULT     hr = S_OK;
+    ULONG64     viewOffset;
+    ULONG64     available;
+
+    *Data = NULL;
+    *MappedSize = 0;
+
+    if ((Size == 0) || (Offset >= DumpFile->FileSize)) {
+        hr = HRESULT_FROM_WIN32(ERROR_HANDLE_EOF);
+        goto Exit;
+    }
+
+    if ((DumpFile->View == NULL) ||
+        (Offset < DumpFile->ViewOffset) ||
+        (Offset >= (DumpFile->ViewOffset + DumpFile->ViewSize))) {
+        if (DumpFile->View != NULL) {
+            UnmapViewOfFile(DumpFile->View);
+            DumpFile->View = NULL;
+        }
+
+        //
+        // Views start on an allocation granularity boundary.
+        //
+        viewOffset = Offset - (Offset % DumpFile->AllocationGranularity);
+        DumpFile->ViewSize = (SIZE_T)min((ULONG64)DUMP_FILE_VIEW_SIZE, DumpFile->FileSize - viewOffset);
+        DumpFile->View = (PUCHAR)MapViewOfFile(DumpFile->Mapping,
+                                               FILE_MAP_READ,
+                                               (DWORD)(viewOffset >> 32),
+                                               (DWORD)viewOffset,
+                                               DumpFile->ViewSize);
+        if (DumpFile->View == NULL) {
+            hr = HRESULT_FROM_WIN32(GetLastError());
+            LogLibErrorPrintf(
+                hr,
+                __LINE__,
+                WIDEN(__FUNCTION__),
+                __WFILE__,
+                L" Failed to map a view of the dump file at 0x%I64x",
+                viewOffset);
+            DumpFile->ViewSize = 0;
+            goto Exit;
+        }
+
+        DumpFile->ViewOffset = viewOffset;
+    }
+
+    available = DumpFile->ViewOffset + DumpFile->ViewSize - Offset;
+
+    *Data = DumpFile->View + (SIZE_T)(Offset - DumpFile->ViewOffset);
+    *MappedSize = (SIZE_T)min(available, Size);
+
+Exit:
+
+    return hr;
+}
+
+
+HRESULT
+DumpFileRead(
+    _Inout_ PDUMP_FILE DumpFile,
+    _In_ ULONG64 Offset,
+    _Out_writes_bytes_(Size) PVOID Buffer,
+    _In_ SIZE_T Size
+    )
+/*++
+
+Routine Description:
+
+    Copies Size bytes of the dump file at Offset to Buffer. Fails if they are
+    not all in the file.
+
+--*/
+{
+    HRESULT         hr = S_OK;
+    PUCHAR          target = (PUCHAR)Buffer;
+    const UCHAR*    data;
+    SIZE_T          mappedSize;
+
+    if ((Offset > DumpFile->FileSize) || (Size > (DumpFile->FileSize - Offset))) {
+        hr = HRESULT_FROM_WIN32(ERROR_HANDLE_EOF);
+        goto Exit;
+    }
+
+    while (Size > 0) {
+        if (FAILED(hr = DumpFileMap(DumpFile, Offset, Size, &data, &mappedSize))) {
+            goto Exit;
+        }
+
+        memcpy(target, data, mappedSize);
+        target += mappedSize;
+        Offset += mappedSize;
+        Size -= mappedSize;
+    }
+
+Exit:
+
+    return hr;
+}
+
+
+HRESULT
+DumpFileCopyToDevice(
+    _Inout_ PDUMP_FILE DumpFile,
+    _In_ ULONG64 Offset,
+    _In_ ULONG64 Size,
+    _Inout_ DEVICE_IO* OutFile
+    )
+/*++
+
+Routine Description:
+
+    Writes Size bytes of the dump file at Offset to OutFile, straight from the
+    views of the mapping; there is no intermediate buffer.
+
+Arguments:
+
+    DumpFile - The opened dump file.
+
+    Offset - Byte offset into the dump file.
+
+    Size - Number of bytes to copy.
+
+    OutFile - Opened file to write to, at its current position.
+
+Return Value:
+
+    HRESULT.
+
+--*/
+{
+    HRESULT         hr = S_OK;
+    const UCHAR*    data;
+    SIZE_T          mappedSize;
+    size_t          bytesWritten;
+
+    if ((Offset > DumpFile->FileSize) || (Size > (DumpFile->FileSize - Offset))) {
+        hr = HRESULT_FROM_WIN32(ERROR_HANDLE_EOF);
+        LogLibErrorPrintf(
+            hr,
+            __LINE__,
+            WIDEN(__FUNCTION__),
+            __WFILE__,
+            L" Range 0x%I64x, 0x%I64x bytes, is past the end of the dump file.",
+            Offset,
+            Size);
+        goto Exit;
+    }
+
+    while (Size > 0) {
+        if (FAILED(hr = DumpFileMap(DumpFile, Offset, Size, &data, &mappedSize))) {
+            goto Exit;
+        }
+
+        bytesWritten = 0;
+        if (FAILED(hr = OutFile->Write((PCHAR)data, mappedSize, &bytesWritten))) {
+            LogLibErrorPrintf(
+                hr,
+                __LINE__,
+                WIDEN(__FUNCTION__),
+                __WFILE__,
+                L" ERROR: Failed to write to %s.",
+                OutFile->GetDeviceName().c_str());
+            goto Exit;
+        }
+        else if (bytesWritten != mappedSize) {
+            hr = E_FAIL;
+            LogLibErrorPrintf(
+                hr,
+                __LINE__,
+                WIDEN(__FUNCTION__),
+                __WFILE__,
+                L" ERROR: Write incorrect number of bytes, Expected: %#Ix  Actual: %#Ix",
+                mappedSize,
+                bytesWritten);
+            goto Exit;
+        }
+
+        Offset += mappedSize;
+        Size -= mappedSize;
+    }
+
+Exit:
+
+    return hr;
+}
+
+
+_Ret_maybenull_
+const DUMP_FILE_BLOB*
+DumpFileFindBlob(
+    _In_ PDUMP_FILE DumpFile,
+    _In_ const GUID* Tag
+    )
+/*++
+
+Routine Description:
+
+    Returns the first secondary data blob with the given tag, or NULL.
+
+--*/
+{
+    ULONG   index;
+
+    for (index = 0; index < DumpFile->BlobCount; index++) {
+        if (IsEqualGUID(DumpFile->Blobs[index].Tag, *Tag)) {
+            return &DumpFile->Blobs[index];
+        }
+    }
+
+    return NULL;
+}
+
+
+HRESULT
+DumpFilePhysicalToOffset(
+    _In_ PDUMP_FILE DumpFile,
+    _In_ ULONG64 PhysicalAddress,
+    _Out_ PULONG64 FileOffset,
+    _Out_ PULONG64 BytesInRun
+    )
+/*++
+
+Routine Description:
+
+    Finds the run holding a physical address.
+
+Arguments:
+
+    DumpFile - The opened dump file.
+
+    PhysicalAddress - Physical address to look up.
+
+    FileOffset - Receives where the byte at PhysicalAddress is in the dump
+        file.
+
+    BytesInRun - Receives the number of bytes from PhysicalAddress to the end
+        of its run.
+
+Return Value:
+
+    HRESULT, HRESULT_FROM_WIN32(ERROR_NOT_FOUND) when the address is in no run.
+
+--*/
+{
+    ULONG64     page = PhysicalAddress / PAGE_SIZE;
+    ULONG       index;
+
+    *FileOffset = 0;
+    *BytesInRun = 0;
+
+    for (index = 0; index < DumpFile->RunCount; index++) {
+        PDUMP_FILE_RUN run = &DumpFile->Runs[index];
+
+        if ((page >= run->BasePage) && ((page - run->BasePage) < run->PageCount)) {
+            *FileOffset = run->FileOffset + (PhysicalAddress - (run->BasePage * PAGE_SIZE));
+            *BytesInRun = ((run->BasePage + run->PageCount) * PAGE_SIZE) - PhysicalAddress;
+            return S_OK;
+        }
+    }
+
+    return HRESULT_FROM_WIN32(ERROR_NOT_FOUND);
+}
@@ -0,0 +1,123 @@
+/*++
+
+    Copyright (C) Microsoft. All rights reserved.
+
+Module Name:
+   DumpFile.h
+
+Abstract:
+   Native parser of the full Windows dump files written by raw2dump and
+   offdumptool: a DUMP_HEADER32 or DUMP_HEADER64, the pages of each physical
+   memory run back to back, then the secondary data, a DUMP_BLOB_FILE_HEADER
+   followed by DUMP_BLOB_HEADER tagged blobs. The dump file is mapped read
+   only and walked DUMP_FILE_VIEW_SIZE at a time, so that no debugger engine
+   is needed to get at the memory or the secondary data.
+
+Environment:
+   User Mode
+
+--*/
+
+#pragma once
+
+#include "common.h"
+#include <ntiodump.h>
+
+#define DUMP_FILE_VIEW_SIZE     0x4000000
+
+typedef struct _DUMP_FILE_RUN
+{
+    ULONG64     BasePage;
+    ULONG64     PageCount;
+
+    //
+    // Where the first page of the run is in the dump file.
+    //
+    ULONG64     FileOffset;
+} DUMP_FILE_RUN, *PDUMP_FILE_RUN;
+
+typedef struct _DUMP_FILE_BLOB
+{
+    GUID        Tag;
+
+    //
+    // Where the data of the blob is in the dump file, past its header and
+    // pre pad.
+    //
+    ULONG64     DataOffset;
+    ULONG       DataSize;
+} DUMP_FILE_BLOB, *PDUMP_FILE_BLOB;
+
+typedef struct _DUMP_FILE
+{
+    HANDLE          File;
+    HANDLE          Mapping;
+    ULONG64         FileSize;
+    ULONG           AllocationGranularity;
+
+    //
+    // Current view of the mapping.
+    //
+    PUCHAR          View;
+    ULONG64         ViewOffset;
+    SIZE_T          ViewSize;
+
+    BOOL            Is64Bit;
+    ULONG           RunCount;
+    PDUMP_FILE_RUN  Runs;
+
+    ULONG64         SecondaryDataOffset;
+    ULONG           BlobCount;
+    PDUMP_FILE_BLOB Blobs;
+} DUMP_FILE, *PDUMP_FILE;
+
+HRESULT
+DumpFileOpen(
+    _In_ LPCWSTR FileName,
+    _Out_ PDUMP_FILE DumpFile
+    );
+
+VOID
+DumpFileClose(
+    _Inout_ PDUMP_FILE DumpFile
+    );
+
+HRESULT
+DumpFileMap(
+    _Inout_ PDUMP_FILE DumpFile,
+    _In_ ULONG64 Offset,
+    _In_ ULONG64 Size,
+    _Outptr_result_bytebuffer_(*MappedSize) const UCHAR** Data,
+    _Out_ PSIZE_T MappedSize
+    );
+
+HRESULT
+DumpFileRead(
+    _Inout_ PDUMP_FILE DumpFile,
+    _In_ ULONG64 Offset,
+    _Out_writes_bytes_(Size) PVOID Buffer,
+    _In_ SIZE_T Size
+    );
+
+HRESULT
+DumpFileCopyToDevice(
+    _Inout_ PDUMP_FILE DumpFile,
+    _In_ ULONG64 Offset,
+    _In_ ULONG64 Size,
+    _Inout_ DEVICE_IO* OutFile
+    );
+
+_Ret_maybenull_
+const DUMP_FILE_BLOB*
+DumpFileFindBlob(
+    _In_ PDUMP_FILE DumpFile,
+    _In_ const GUID* Tag
+    );
+
+HRESULT
+DumpFilePhysicalToOffset(
+    _In_ PDUMP_FILE DumpFile,
+    _In_ ULONG64 PhysicalAddress,
+    _Out_ PULONG64 FileOffset,
+    _Out_ PULONG64 BytesInRun
+    );
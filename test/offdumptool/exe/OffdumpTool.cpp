@@ -1,734 +1,1185 @@
-/*++
-
-    Copyright (C) Microsoft. All rights reserved.
-
-Module Name:
-   offdumptool.cpp
-
-Environment:
-   User Mode
-
-Author:
-   Rajib Dutta (radutta )
---*/
-
-#include "common.h"
-#include "DiskUtil.h"
-#include "DumpUtil.h"
-#include "apreg64.h"
-
-
-VOID
-Usage()
-{
-    wprintf(
-            L"offlinedump test tool.\n"
-            L"Background and Assumptions:\n"
-            L"    This utility:\n"
-            L"          - Takes input that conforms to the Microsoft Offline Dump Specification\n"
-            L"          - Must be run as an administrator\n"
-            L"          - Denotes System under Test (SUT) as the System that crashed\n"
-            L"          - Denotes Debug System (DS) as system running the Windows debugger\n"
-            L"          \n"
-
-
-
-            L"    The System Under Test (SUT):\n"
-            L"          - Has a disk partition suitable for storing an offline crash\n"
-            L"          - May be distinct from the Debug System (DS)\n"
-            L"          - May be a different system architecture from the Debug System\n"
-            L"          \n"
-            L"    To expedite debugging, two distinct systems are recommended\n"
-            L"    This is based on assumption, relative to SUT:\n"
-            L"          - The Debug System has greater stability\n"
-            L"          - The Debug System has higher performance\n"
-            L"          \n"
-
-
-            L"    The file extension has the following conventions:\n"
-            L"          .RAW (Raw Partition saved as a File)\n"
-            L"               [Output or Input to Tool]\n"
-            L"          .DMP (Windows Dump File loadable by Windows Debugger)\n"
-            L"               [Output from Tool]\n"
-            L"               Windows Phone: [Input to Tool]\n"
-            L"          .BIN (Silicon Vendor Specific BIN File)\n"
-            L"               [Output from Tool]\n"
-            L"          .DDR (DDR memory sections File)\n"
-            L"               [Input to Tool]\n"
-            L"          \n"
-            L"          \n"
-
-            L"BASIC Usage Commands:\n"
-            L"     /help\n"
-            L"          This help text\n"
-            L"          \n"
-
-            L"     /parsepart\n"
-            L"          This will Parse the Raw_Dump Partition and create:\n"
-            L"              .DMP = Windows Dump file \n"
-            L"              .BIN = Silicon vendor specific bins\n"
-            L"          Example: offlinedumptool /parsepart\n"
-            L"          Note: Must run command on System under Test (SUT)\n"
-            L"          Output file: raw_dump.DMP, <possibly others>\n"
-            L"          Exact output filenames encoded in headers of Offline Specification\n"
-            L"          \n"
-
-            L"     /dumprawpart <DUMPFILE.RAW>\n"
-            L"          This will dump the raw dump partition to a file. \n"
-            L"          Example: offlinedumptool /dumprawpart dumpfile.raw\n"
-            L"          Note: Must run command on System under Test (SUT)\n"
-            L"          Output .RAW file is further processed using the /parsedump option\n"
-            L"          \n"
-
-            L"     /parsedump <DUMPFILE.RAW> \n"
-            L"          This will open the Raw_Dump Partition file as raw dump and parse the headers. \n"
-            L"          Example: offlinedumptool /parsedump DUMPFILE.RAW \n"
-            L"          Note: .BIN file can be processed using this utility on Debug System\n"
-            L"          Exact output filenames encoded in headers of Offline Specification\n"
-            L"          Output file: raw_dump.DMP\n"
-            L"          option /noapreg will not attempt to process APREG section\n"
-            L"          \n"
-
-            L"     /parsewpdump <WP_DUMPFILE.DMP>\n"
-            L"          It will extract WP silicon vendor sections from WP dump secondary data and save as .bins \n"
-            L"          Example: offlinedumptool /parsewpdump memory.dmp\n"
-            L"          Note: Windows Phone Specific Option, all other options are supported exclusively for Windows\n"
-            L"                Must run command on .DMP file from Windows Phone System under Test (SUT)\n"
-            L"                The input .DMP file is generated from another Windows Phone tool\n"
-            L"          Output file(s): <section>.BIN ...\n"
-            L"          Exact output filenames encoded in headers of Offline Specification\n"
-            L"          \n"
-            
-            L"     OPTIONAL ADD ON COMMANDS :-\n"
-            L"     /noapreg \n"
-            L"          Does not attempt to find APREG in the DDR sections\n"
-            L"          \n"
-            L"     /apreg64 <address in Hex> \n"
-            L"          Assumes the APREG format to of 64 bit and attempts to find the MSM_DUMP_TABLE \n"
-            L"          at that location.\n"
-            L"          \n"
-
-
-            L"RECOMMENDED Usage Commands:\n"
-            L"          For example on Windows Systems Under Test (SUT), option A or B:\n"
-            L"          A)  Raw Partition -- > Raw File -- > .DMP, .BIN(s)\n"
-            L"              -----------------------------------------------------------\n"
-            L"              /dumprawpart (on SUT)            /parsedump, windbg (on DS)\n"
-            L"          \n"
-            L"              1) 'offlinedumptool /dumprawpart dump.raw' (on SUT)\n"
-            L"                 output is user specified 'dump.raw' file\n"
-            L"              2) 'offlinedumptool /parsedump dump.raw' (on DS)\n"
-            L"                 output is .DMP file (windbg loadable)\n"
-            L"                 output is .BIN file(s) (as specified in .RAW file)\n"
-            L"              3) 'windbg -z crash.dmp' (on DS)\n"
-
-            L"          \n"
-            L"          B)  Raw Partition       ----- >      .DMP, .BIN(s)\n"
-            L"              --------------------------------------------------\n"
-            L"              /parsepart (on SUT)              windbg (on DS)\n"
-            L"          \n"
-            L"              1) 'offlinedumptool /parsepart' (on SUT)\n"
-            L"                 output is .DMP file (windbg loadable)\n"
-            L"                 output is .BIN file(s) (as specified in .RAW file)\n"
-            L"              2) 'windbg -z crash.dmp' (on DS)\n"
-
-            L"          \n"
-
-
-            L"          For Windows Phone Systems Under Test (SUT):\n"
-            L"          A)  .DMP File (generated on SUT)      -- > .BIN(s)\n"
-            L"              -----------------------------------------------\n"
-            L"              /parsewpdump wp_dumpfile.dmp, windbg (on DS)\n"
-            L"          \n"
-            L"              1) 'offlinedumptool /parsewpdump wp_dumpfile.DMP' (on DS)\n"
-            L"                 output is .BIN file(s) (as specified in .DMP file)\n"
-            L"              2) 'windbg -z wp_dumpfile.dmp' (on DS)\n"
-            L"          \n"
-
-
-    );
-}
-
-
-
-DWORD GetFileVersionString (
-    __in LPTSTR pFileName, 
-    __in LPTSTR StringBuffer,
-    __in UINT   BufferLengthInCharacters
-    )
-{
-    BOOL   Status            = TRUE;
-    DWORD  RetVal            = 0;
-    DWORD  Size              = 0;
-    DWORD  Handle            = 0;
-    PVOID  pData             = NULL;
-    PDWORD pTranslation      = NULL;
-    PVOID  pRequestedData    = NULL;
-    UINT   RequestedDataSize = 0;
-    DWORD  DefaultLang       = 0x409;
-
-    #define GfvsKeyLength 80
-    
-    WCHAR Key[GfvsKeyLength];
-
-    RtlZeroMemory (Key, sizeof(WCHAR) * GfvsKeyLength);
-
-    //
-    // Get the size of the File Version Info
-    //
-    Size = GetFileVersionInfoSize(pFileName, &Handle);
-
-    if (0 == Size)
-    {
-        RetVal = GetLastError();
-        return RetVal;
-    }
-
-    //
-    // Allocate memory for the File Version Info
-    //
-    pData = calloc(1, Size);
-
-    if (NULL == pData)
-    {
-        RetVal = ERROR_NOT_ENOUGH_MEMORY;  
-        goto Exit;
-    }        
-
-    //
-    // Get the File Version Info
-    //
-    Status = GetFileVersionInfo (
-        pFileName,
-        Handle,
-        Size,
-        pData
-        );
-
-    if (!Status)
-    {
-        RetVal = GetLastError();
-        goto Exit;
-    }
-
-    //
-    // Get language details
-    //
-    Status = VerQueryValue (
-        pData,
-        L"\\VarFileInfo\\Translation",
-        (PVOID *) & pTranslation,
-        & RequestedDataSize
-        );
-
-    if (!Status)
-    {        
-        RetVal = GetLastError();
-
-        //
-        // No VarFileInfo translation, assuming default language.
-        //
-        pTranslation = &DefaultLang;
-        RequestedDataSize = sizeof (DWORD);
-
-        //
-        // Ignore previous error
-        //        
-        RetVal = 0;
-    }
-
-    //
-    // Create the query string
-    //
-    RetVal = StringCchPrintf (
-        Key,
-        GfvsKeyLength,
-        L"\\StringFileInfo\\%04x%04x\\FileVersion",
-        LOWORD(*pTranslation), 
-        HIWORD(*pTranslation)
-        );
-
-    if (0 != RetVal)
-    {
-        goto Exit;
-    }
-
-    //
-    // Query the FileVersion
-    //
-    Status = VerQueryValue(
-        pData,
-        Key,
-        & pRequestedData,
-        & RequestedDataSize
-        );
-
-    if (!Status)
-    {
-        RetVal = GetLastError();
-        goto Exit;
-    }        
-
-    //
-    // Check to see that we have enough room
-    //
-    if (RequestedDataSize > sizeof(WCHAR) * BufferLengthInCharacters)
-    {
-        RetVal = ERROR_BUFFER_OVERFLOW;
-        goto Exit;
-    }
-
-    //
-    // Copy the requested data
-    //
-    RetVal = StringCchPrintf (
-        StringBuffer, 
-        BufferLengthInCharacters, 
-        (LPWSTR) pRequestedData
-        );
-
-Exit:
-    if (pData)
-    {
-        free (pData);
-    }
-    return RetVal;
-}
-
-HRESULT
-ParseCommandLine(
-    __in_ecount(argc) WCHAR const * const argv[],
-    DWORD argc,
-    __inout PCOMMAND_LINE_ARGS arguments
-    )
-{
-    HRESULT result = ERROR_SUCCESS;
-    DWORD i;
-
-    for(i=1; i<argc; ++i) {
-        if(argv[i][0]=='/' || argv[i][0]=='-') {
-            const WCHAR *arg = &argv[i][1];
-            if(_wcsicmp(arg, L"?") == 0 || _wcsicmp(arg, L"help") == 0 ) {
-                arguments->DisplayUsage = TRUE;
-            }
-            else if(_wcsicmp(arg, L"parsedump") == 0) {
-                if(i + 1 < argc){
-                     arguments->ParseDump = TRUE;
-                     arguments->FileName = (PWSTR )&argv[i+1][0];
-                     i++;
-                }
-            }
-            else if (_wcsicmp(arg, L"noapreg") == 0) {
-                arguments->DoNotParseAPREG = TRUE;
-            }
-            else if (_wcsicmp(arg, L"device") == 0) {                
-                if(wcscmp(argv[i+1], L"8994") == 0) {
-                    arguments->sharedIMEM = TRUE;
-                }
-                else if(wcscmp(argv[i+1], L"8916") == 0) {
-                    arguments->sharedIMEM = FALSE;
-                }
-                
-            }
-            else if (_wcsicmp(arg, L"apreg64") == 0)  {
-                arguments->apreg64 = TRUE;
-                 if(i + 1 < argc){
-                     arguments->apreg64TableAddr.QuadPart = _wcstoui64(argv[i+1], NULL, 16);                 
-                     i++;
-                }                
-            }
-            else if(_wcsicmp(arg, L"parsepart") == 0) {
-                arguments->PasePartition = TRUE;
-                arguments->DumpDDR = TRUE;
-            }
-            else if(_wcsicmp(arg, L"dumpddr") == 0) {
-                arguments->DumpDDR = TRUE;
-            }
-            else if(_wcsicmp(arg, L"checkdebug") == 0) {
-                arguments->CheckDebugPolicy = TRUE;
-            }
-            else if(_wcsicmp(arg, L"checkevent") == 0) {
-                arguments->CheckOfflineDumpEvent = TRUE;
-            }
-            else if(_wcsicmp(arg, L"checkeventUI") == 0) {
-                arguments->CheckOfflineDumpEventUI = TRUE;
-            } 
-            else if(_wcsicmp(arg, L"checkdump") == 0) {
-                arguments->CheckValidDump = TRUE;
-            }
-            else if(_wcsicmp(arg, L"wipedump") == 0) {
-                arguments->WipeRawDumpHeader = TRUE;
-            }  
-            else if(_wcsicmp(arg, L"createpart") == 0) {
-                arguments->CreatePart = TRUE;
-            }
-            else if(_wcsicmp(arg, L"dumprawpart") == 0) {
-                if(i + 1 < argc){
-                     arguments->DumpRawPartition = TRUE;
-                     arguments->FileName = (PWSTR )&argv[i+1][0];
-                     i++;
-                }
-            }
-            else if(_wcsicmp(arg, L"ParseWPdump") == 0) {
-                if(i + 1 < argc){
-                     arguments->ParseWPdump = TRUE;
-                     arguments->FileName = (PWSTR )&argv[i+1][0];
-                     i++;
-                }
-            }  
-            else if(_wcsicmp(arg, L"ddr2dmp") == 0) {
-                arguments->GenDMPFormDDR = TRUE;
-            } 
-            else if (_wcsicmp(arg, L"ddr") == 0) {
-                if (i + 2 < argc) {
-                    arguments->ddr[arguments->DDRCount].DDRBase.QuadPart = _wcstoui64(argv[i + 1], NULL, 16);
-                    arguments->ddr[arguments->DDRCount].DDRFileName = (PWSTR)&argv[i + 2][0];
-                    arguments->ddr[arguments->DDRCount].AlreadyMerged = FALSE;
-                    arguments->DDRCount++;
-                    i += 2;
-                }
-            }
-            else {
-                wprintf(L"Unexpected command line argument '%s'.\n", argv[i]);
-                result = E_INVALIDARG;
-                goto Exit;
-                }
-            }
-    }
-
-Exit:
-
-    return result;
-}
-
-VOID
-DumpGUID(
-    _In_ GUID*  Guid
-    )
-{
-    LogLibInfoPrintf(L"\t                GUID: {%08X-%04X-%04X-%02X%02X-%02X%02X%02X%02X%02X%02X}",
-                Guid->Data1, Guid->Data2, Guid->Data3,
-                Guid->Data4[0], Guid->Data4[1], Guid->Data4[2],
-                Guid->Data4[3], Guid->Data4[4], Guid->Data4[5],
-                Guid->Data4[6], Guid->Data4[7]);
-}
-
-int __cdecl
-wmain (
-    DWORD argc,
-    __in_ecount(argc) WCHAR const * const argv[]
-    )
-{
-    HANDLE hVol = NULL;
-    LPWSTR logName = L"OfflineDumpTool.wtl";
-    HRESULT result = ERROR_SUCCESS;
-    DMP_CONTEXT context = { 0 };
-    NTSTATUS status = STATUS_SUCCESS;
-    LPWSTR mergedfile = L"merged.bin";
-    WCHAR ProgramFileVersion[MAX_PATH];
-    COMMAND_LINE_ARGS CommandLineArgs = { 0 };
-    DWORD FileVersion = 0;
-
-    //
-    // Init the Context 
-    //
-    context.HasValidAP_REG = TRUE;
-    context.IsAPREGRequested = TRUE;
-    context.DedicatedDumpHandle = INVALID_HANDLE_VALUE;
-
-    LogLibCreateLog(logName);
-    
-#if 0
-    LogLibInfoPrintf(L"\n====PRIVATE BUILD. PLEASE DO NOT DISTRIBUTE====\n");
-#endif
-    
-    FileVersion = GetFileVersionString(
-                    NAME_EXECUTABLE,
-                    ProgramFileVersion,
-                    MAX_PATH
-                    );
-    if( FileVersion == 0)
-    {
-        LogLibInfoPrintf(L"\n====Offline Dump Tool Version = %s====\n", ProgramFileVersion);
-    }
-    else
-    {
-        LogLibInfoPrintf(L"Version unavailable");
-    }
-
-    LogLibLogMachineInfo();
-   
-    // Start the COM interface.
-    //
-    result = CoInitializeEx( NULL, COINIT_MULTITHREADED );
-    result = CoInitializeSecurity(NULL,
-                              -1,
-                              NULL,
-                              NULL,
-                              RPC_C_AUTHN_LEVEL_CONNECT,
-                              RPC_C_IMP_LEVEL_IMPERSONATE,
-                              NULL,
-                              0,
-                              NULL);
-
-    if (FAILED(result))  {
-        LogLibInfoPrintf(L"Failed to coinitialize");
-    }
-    
-    result = ParseCommandLine(argv, argc, &CommandLineArgs);
-    if(result != ERROR_SUCCESS) {
-        goto Exit;
-    }    
-
-    if(CommandLineArgs.DisplayUsage == TRUE || argc == 1 ) {
-        Usage();
-        goto Exit;
-    }
-    
-    if (CommandLineArgs.sharedIMEM == TRUE) {
-        LogLibStartTest(L"Shared IMEM is different than IMEM BASE\n");
-        g_Shared_IMEM = TRUE;
-    }
-    
-    if (CommandLineArgs.apreg64 == TRUE) {
-        LogLibStartTest(L"64 bit APREG format is chosen\n");
-        context.isAPREG64 = TRUE;
-        context.APRegAddress.QuadPart = CommandLineArgs.apreg64TableAddr.QuadPart;
-        wprintf(L"context.APRegAddress.QuadPart: 0x%I64x\n", context.APRegAddress.QuadPart);       
-    }
-    
-    if( CommandLineArgs.DoNotParseAPREG == TRUE) {
-        LogLibStartTest(L"APREG update is not requested \n");
-        context.IsAPREGRequested = FALSE;
-        context.isAPREG64 = FALSE;            
-    }  
-    
-    if (CommandLineArgs.CheckDebugPolicy == TRUE) {
-          LogLibStartTest(L"Checking if the Device Debug policy is enabled or not\n");
-          if( CheckDebugPolicyEnabled())  {
-               LogLibInfoPrintf(L"The machine debug policy is enabled");
-          }
-          else {
-               LogLibErrorPrintf(
-                result,
-                __LINE__,
-                WIDEN(__FUNCTION__),
-                __WFILE__, 
-                L"Error: Debug Policy is not enabled. This device cannot use the offline ram dump feature");
-          }
-          LogLibEndTest(L"Checking if the Device Debug policy is enabled or not\n");
-    }
-    if (CommandLineArgs.CheckOfflineDumpEvent == TRUE) {
-          LogLibStartTest(L"Check Abnormal Reset Event\n");
-          if( QueryAbnromalResetEvents())  {
-               LogLibInfoPrintf(L"there is an abnormal reset event");
-          }
-          else {
-               LogLibErrorPrintf(
-                result,
-                __LINE__,
-                WIDEN(__FUNCTION__),
-                __WFILE__, 
-                L"Error: not Found the Abnormal Reset Event");
-          }
-          LogLibEndTest(L"Check Abnormal Reset Event\n");
-    }
-    else if (CommandLineArgs.CheckOfflineDumpEventUI == TRUE) {
-          if( QueryAbnromalResetEvents())  {
-               MessageBox(NULL, 
-                          L"Oh! Your machine just hit a hard hang!\r\n Please run offline dump collection script on the desk to collect the dump then send a mail to platform support alias!",
-                          NULL,
-                          MB_OK);
-            }
-    }
-    else if (CommandLineArgs.CheckValidDump == TRUE) {
-          if( ExistValidOfflineDump(&context))  {
-               MessageBox(NULL, 
-                          L"Oh! Your machine just hit a hard hang!\r\n Please run offline dump collection script on the desk to collect the dump then send a mail to platform support alias!",
-                          NULL,
-                          MB_OK);
-            }
-    }
-    else if (CommandLineArgs.WipeRawDumpHeader == TRUE) {
-          if(!WipeRawDumpHeader(&context))  {
-              result = 1; 
-            }
-    }
-    else if( CommandLineArgs.ParseDump == TRUE) {        
-        LogLibStartTest(L"Read and Parse offline Dump from File\n");
-        if(CommandLineArgs.DumpDDR == TRUE) {
-            context.DumpDDR = TRUE;
-            LogLibInfoPrintf(L"Will Dump DDR sections to files");
-         }
-        LogLibInfoPrintf(L"Read from File %s", CommandLineArgs.FileName);
-        status = ExtractRawDumpFileToFiles(&context, CommandLineArgs.FileName);
-        if (!NT_SUCCESS(status)) {
-            LogLibErrorPrintf(
-                result,
-                __LINE__,
-                WIDEN(__FUNCTION__),
-                __WFILE__, 
-                L"Error: ReadDumpFromFile Failed : %d\n",
-                GetLastError());
-        }
-        LogLibEndTest(L"Read and Parse offline Dump from File\n");
-    }
-     else if( CommandLineArgs.PasePartition == TRUE) {
-         LogLibStartTest(L"Extract Raw_Dump Partition To Windows Dump and Silicon Bin Files\n");
-         if(CommandLineArgs.DumpDDR == TRUE) {
-            context.DumpDDR = TRUE;
-            LogLibInfoPrintf(L"Will Dump DDR sections to files");
-         }
-         status = ExtractRawDumpPartitionToFiles(&context);
-          if(!NT_SUCCESS(status)) {
-            result = E_FAIL;
-            LogLibErrorPrintf(
-                result,
-                __LINE__,
-                WIDEN(__FUNCTION__),
-                __WFILE__, 
-                L"Error: ExtractRawDumpPartitionToFiles Failed : %d\n",
-                GetLastError());
-            }
-          LogLibEndTest(L"Extract Raw_Dump Partition To Windows Dump and Silicon Bin Files\n");
-    } 
-     else if( CommandLineArgs.CreatePart == TRUE) {
-        LogLibStartTest(L"Create Raw_Dump Partition\n");
-        hVol = CreateGPTRawDumpPartition();
-        if(INVALID_HANDLE_VALUE == hVol) {
-            result = E_FAIL;
-            LogLibErrorPrintf(
-                result,
-                __LINE__,
-                WIDEN(__FUNCTION__),
-                __WFILE__, 
-                L"Error: Create Raw Dump Parition Failed : %d\n",
-                GetLastError());
-        }
-        LogLibEndTest(L"Create Raw_Dump Partition\n");
-    }
-    else if( CommandLineArgs.ParseWPdump == TRUE) {
-        LogLibStartTest(L"Parse Windows Phone Dump File to Extract SV bins \n");
-        result = ExtractSecondaryDataFromDumpFile(CommandLineArgs.FileName);
-        if(FAILED(result)) {
-            result = E_FAIL;
-            LogLibErrorPrintf(
-                result,
-                __LINE__,
-                WIDEN(__FUNCTION__),
-                __WFILE__, 
-                L"Error: Parse Windows Phone Dump File and Extract SV bins  Failed : %d\n",
-                GetLastError());
-        }
-        LogLibEndTest(L"Parse Windows Phone Dump File to Extract SV bins \n");
-
-        LogLibStartTest(L"Parse Windows Phone Dump File to reconstruct DDR bins \n");
-        result = ReconstructDDRSectionsFromDumpFile(CommandLineArgs.FileName);
-        if(FAILED(result)) {
-            result = E_FAIL;
-            LogLibErrorPrintf(
-                result,
-                __LINE__,
-                WIDEN(__FUNCTION__),
-                __WFILE__, 
-                L"Error: Parse Windows Phone Dump File and reconstruct DDR bins  Failed : %d\n",
-                GetLastError());
-        }
-        LogLibEndTest(L"Parse Windows Phone Dump File to reconstruct DDR bins bins \n");
-    }
-    else if( CommandLineArgs.GenDMPFormDDR == TRUE) {
-        LogLibStartTest(L"Try Carve Windows Dump File from DDR Sections \n");     
-        if(!MergeDDRFiles(&context, &CommandLineArgs, mergedfile)) {
-            LogLibErrorPrintf(
-                E_FAIL,
-                __LINE__,
-                WIDEN(__FUNCTION__),
-                __WFILE__, 
-                L"Error:  Failed to merged Files\n");
-       } 
-       else
-       {
-           // now need process thie dump file now.
-            result = ExtractWindowsDumpFromDDR(&context, mergedfile);
-            if(FAILED(result)) {
-                result = E_FAIL;
-                LogLibErrorPrintf(
-                    result,
-                    __LINE__,
-                    WIDEN(__FUNCTION__),
-                    __WFILE__, 
-                    L"Error:  Carving the Windows Dump file from the Merged DDR Sections  Failed : %d\n",
-                    GetLastError());
-            }
-       }
-       
-       LogLibEndTest(L"Try Carve Windows Dump File from DDR Sections \n");
-    }
-
-    else if( CommandLineArgs.DumpRawPartition == TRUE) {
-        LogLibStartTest(L"Directly extracting Raw_Dump Partition to a single file\n");
-        status = FindDumpPartition(&context);
-        if (status != ERROR_SUCCESS){
-            // The script that wraps this tool expects the tool to return postive value for failure.
-            result = 1;    
-            LogLibErrorPrintf(
-                                E_FAIL,
-                                __LINE__,
-                                WIDEN(__FUNCTION__),
-                                __WFILE__, 
-                                L"Error: Locating the RAW_Dump Partition  failed : %d\n",
-                                GetLastError());
-        }
-        else {
-            if(!ReadRawDumpPartitionToFile(&context,
-                                    CommandLineArgs.FileName )) {
-                // The script that wraps this tool expects the tool to return postive value for failure.
-                result = 2;
-                LogLibErrorPrintf(
-                                E_FAIL,
-                                __LINE__,
-                                WIDEN(__FUNCTION__),
-                                __WFILE__, 
-                                L"Error: Extracting from the RAW_Dump partition failed : %d\n",
-                                GetLastError());
-            }
-         }
-         LogLibEndTest(L"Directly extract Raw_Dump Partition to single file\n");
-    }
-
-Exit:
-    
-    CoUninitialize();
-
-    if(nullptr != context.pRawDumpSectionTable){
-        free(context.pRawDumpSectionTable);
-    }
-    
-    if(context.DDRMemoryMap != NULL){
-        free(context.DDRMemoryMap);
-    }
-    
-    if(context.DumpHeader != NULL){
-        free(context.DumpHeader);
-    }
-    
-    if(context.ApReg != NULL){
-        free(context.ApReg);
-    }   
-    
-    if(context.KdDebuggerDataBlock != NULL){
-        free(context.KdDebuggerDataBlock);
-    }  
-
-    if (context.DedicatedDumpHandle != INVALID_HANDLE_VALUE){
-        CloseHandle(context.DedicatedDumpHandle);
-        context.DedicatedDumpHandle = INVALID_HANDLE_VALUE;
-    }    
-
-    LogLibCloseLog();
-    
-    return result;
-}
-
-
-
+/*++
+
+    Copyright (C) Microsoft. All rights reserved.
+
+Module Name:
+   offdumptool.cpp
+
+Environment:
+   User Mode
+
+Author:
+   Rajib Dutta (radutta )
+--*/
+
+#include "common.h"
+#include "DiskUtil.h"
+#include "DumpUtil.h"
+#include "apreg64.h"
+#include <shlwapi.h>
+#include <vector>
+#include <string>
+
+//
+// One raw dump of a batch and what became of it.
+//
+typedef struct _BATCH_JOB
+{
+    std::wstring    InputPath;
+    std::wstring    OutputDirectory;
+    NTSTATUS        Status;
+    BOOL            Is64Bit;
+    UINT32          BugCheckCode;
+    ULONGLONG       InputSize;
+    ULONGLONG       ElapsedMs;
+} BATCH_JOB, *PBATCH_JOB;
+
+typedef struct _BATCH_CONTEXT
+{
+    std::vector<BATCH_JOB>      Jobs;
+    volatile LONG               NextJob;
+    PCOMMAND_LINE_ARGS          Arguments;
+    LARGE_INTEGER               Frequency;
+} BATCH_CONTEXT, *PBATCH_CONTEXT;
+
+
+VOID
+Usage()
+{
+    wprintf(
+            L"offlinedump test tool.\n"
+            L"Background and Assumptions:\n"
+            L"    This utility:\n"
+            L"          - Takes input that conforms to the Microsoft Offline Dump Specification\n"
+            L"          - Must be run as an administrator\n"
+            L"          - Denotes System under Test (SUT) as the System that crashed\n"
+            L"          - Denotes Debug System (DS) as system running the Windows debugger\n"
+            L"          \n"
+
+
+
+            L"    The System Under Test (SUT):\n"
+            L"          - Has a disk partition suitable for storing an offline crash\n"
+            L"          - May be distinct from the Debug System (DS)\n"
+            L"          - May be a different system architecture from the Debug System\n"
+            L"          \n"
+            L"    To expedite debugging, two distinct systems are recommended\n"
+            L"    This is based on assumption, relative to SUT:\n"
+            L"          - The Debug System has greater stability\n"
+            L"          - The Debug System has higher performance\n"
+            L"          \n"
+
+
+            L"    The file extension has the following conventions:\n"
+            L"          .RAW (Raw Partition saved as a File)\n"
+            L"               [Output or Input to Tool]\n"
+            L"          .DMP (Windows Dump File loadable by Windows Debugger)\n"
+            L"               [Output from Tool]\n"
+            L"               Windows Phone: [Input to Tool]\n"
+            L"          .BIN (Silicon Vendor Specific BIN File)\n"
+            L"               [Output from Tool]\n"
+            L"          .DDR (DDR memory sections File)\n"
+            L"               [Input to Tool]\n"
+            L"          \n"
+            L"          \n"
+
+            L"BASIC Usage Commands:\n"
+            L"     /help\n"
+            L"          This help text\n"
+            L"          \n"
+
+            L"     /parsepart\n"
+            L"          This will Parse the Raw_Dump Partition and create:\n"
+            L"              .DMP = Windows Dump file \n"
+            L"              .BIN = Silicon vendor specific bins\n"
+            L"          Example: offlinedumptool /parsepart\n"
+            L"          Note: Must run command on System under Test (SUT)\n"
+            L"          Output file: raw_dump.DMP, <possibly others>\n"
+            L"          Exact output filenames encoded in headers of Offline Specification\n"
+            L"          \n"
+
+            L"     /dumprawpart <DUMPFILE.RAW>\n"
+            L"          This will dump the raw dump partition to a file. \n"
+            L"          Example: offlinedumptool /dumprawpart dumpfile.raw\n"
+            L"          Note: Must run command on System under Test (SUT)\n"
+            L"          Output .RAW file is further processed using the /parsedump option\n"
+            L"          \n"
+
+            L"     /parsedump <DUMPFILE.RAW> \n"
+            L"          This will open the Raw_Dump Partition file as raw dump and parse the headers. \n"
+            L"          Example: offlinedumptool /parsedump DUMPFILE.RAW \n"
+            L"          Note: .BIN file can be processed using this utility on Debug System\n"
+            L"          Exact output filenames encoded in headers of Offline Specification\n"
+            L"          Output file: raw_dump.DMP\n"
+            L"          option /noapreg will not attempt to process APREG section\n"
+            L"          \n"
+
+            L"     /parsewpdump <WP_DUMPFILE.DMP>\n"
+            L"          It will extract WP silicon vendor sections from WP dump secondary data and save as .bins \n"
+            L"          Example: offlinedumptool /parsewpdump memory.dmp\n"
+            L"          Note: Windows Phone Specific Option, all other options are supported exclusively for Windows\n"
+            L"                Must run command on .DMP file from Windows Phone System under Test (SUT)\n"
+            L"                The input .DMP file is generated from another Windows Phone tool\n"
+            L"          Output file(s): <section>.BIN ...\n"
+            L"          Exact output filenames encoded in headers of Offline Specification\n"
+            L"          \n"
+            
+            L"     /batch <DIRECTORY | MANIFEST.TXT> [/jobs <N>] [/outdir <DIRECTORY>]\n"
+            L"          Converts many raw dumps in one run, like /parsedump for each of them.\n"
+            L"          A directory is searched for .RAW and .BIN files, a manifest lists one\n"
+            L"          raw dump per line (lines starting with # are skipped).\n"
+            L"          /jobs sets how many dumps are converted at the same time, default is the\n"
+            L"          number of processors. Each dump gets its own folder under /outdir, default\n"
+            L"          is the current directory. A table of results and timings is printed at the end.\n"
+            L"          Example: offlinedumptool /batch d:\\dumps /jobs 4 /outdir d:\\converted\n"
+            L"          \n"
+
+            L"     /query <DUMPFILE.RAW> [<query> [; <query> ...]]\n"
+            L"          Reads memory of the raw dump in place, without converting it. The DDR ranges\n"
+            L"          come from the .r2dx index raw2dump keeps next to the raw dump, or from the\n"
+            L"          section table. Without queries on the command line they are read from the\n"
+            L"          standard input, one per line. Numbers are hex.\n"
+            L"              pa <address> [length]   Dump physical memory\n"
+            L"              va <address> [length]   Dump virtual memory\n"
+            L"              walk <address>          Show the page table entries of a virtual address\n"
+            L"              dtb [address]           Show or set the directory table base\n"
+            L"              bits [32 | 64]          Show or set the page table format\n"
+            L"              scan                    Search the raw dump for the DUMP_HEADER\n"
+            L"              map                     Show the DDR ranges\n"
+            L"          Virtual addresses are translated with ARM64 or 32-bit non-PAE page tables.\n"
+            L"          Example: offlinedumptool /query dumpfile.raw scan ; walk fffff80012345000\n"
+            L"          \n"
+
+            L"     /diff <FIRST.RAW> <SECOND.RAW> [/delta <DELTA.BIN>] [/jobs <N>]\n"
+            L"          Compares two raw dumps page by page without converting them. The pages\n"
+            L"          both raw dumps hold are lined up by physical address and hashed on /jobs\n"
+            L"          threads, default is the number of processors. The physical ranges that\n"
+            L"          changed are printed. /delta writes the changed pages of the second raw\n"
+            L"          dump to a file, each run of pages preceded by its address and page count.\n"
+            L"          Example: offlinedumptool /diff reset1.raw reset2.raw /delta changed.bin\n"
+            L"          \n"
+
+            L"     OPTIONAL ADD ON COMMANDS :-\n"
+            L"     /noapreg \n"
+            L"          Does not attempt to find APREG in the DDR sections\n"
+            L"          \n"
+            L"     /apreg64 <address in Hex> \n"
+            L"          Assumes the APREG format to of 64 bit and attempts to find the MSM_DUMP_TABLE \n"
+            L"          at that location.\n"
+            L"          \n"
+
+
+            L"RECOMMENDED Usage Commands:\n"
+            L"          For example on Windows Systems Under Test (SUT), option A or B:\n"
+            L"          A)  Raw Partition -- > Raw File -- > .DMP, .BIN(s)\n"
+            L"              -----------------------------------------------------------\n"
+            L"              /dumprawpart (on SUT)            /parsedump, windbg (on DS)\n"
+            L"          \n"
+            L"              1) 'offlinedumptool /dumprawpart dump.raw' (on SUT)\n"
+            L"                 output is user specified 'dump.raw' file\n"
+            L"              2) 'offlinedumptool /parsedump dump.raw' (on DS)\n"
+            L"                 output is .DMP file (windbg loadable)\n"
+            L"                 output is .BIN file(s) (as specified in .RAW file)\n"
+            L"              3) 'windbg -z crash.dmp' (on DS)\n"
+
+            L"          \n"
+            L"          B)  Raw Partition       ----- >      .DMP, .BIN(s)\n"
+            L"              --------------------------------------------------\n"
+            L"              /parsepart (on SUT)              windbg (on DS)\n"
+            L"          \n"
+            L"              1) 'offlinedumptool /parsepart' (on SUT)\n"
+            L"                 output is .DMP file (windbg loadable)\n"
+            L"                 output is .BIN file(s) (as specified in .RAW file)\n"
+            L"              2) 'windbg -z crash.dmp' (on DS)\n"
+
+            L"          \n"
+
+
+            L"          For Windows Phone Systems Under Test (SUT):\n"
+            L"          A)  .DMP File (generated on SUT)      -- > .BIN(s)\n"
+            L"              -----------------------------------------------\n"
+            L"              /parsewpdump wp_dumpfile.dmp, windbg (on DS)\n"
+            L"          \n"
+            L"              1) 'offlinedumptool /parsewpdump wp_dumpfile.DMP' (on DS)\n"
+            L"                 output is .BIN file(s) (as specified in .DMP file)\n"
+            L"              2) 'windbg -z wp_dumpfile.dmp' (on DS)\n"
+            L"          \n"
+
+
+    );
+}
+
+
+
+DWORD GetFileVersionString (
+    __in LPTSTR pFileName, 
+    __in LPTSTR StringBuffer,
+    __in UINT   BufferLengthInCharacters
+    )
+{
+    BOOL   Status            = TRUE;
+    DWORD  RetVal            = 0;
+    DWORD  Size              = 0;
+    DWORD  Handle            = 0;
+    PVOID  pData             = NULL;
+    PDWORD pTranslation      = NULL;
+    PVOID  pRequestedData    = NULL;
+    UINT   RequestedDataSize = 0;
+    DWORD  DefaultLang       = 0x409;
+
+    #define GfvsKeyLength 80
+    
+    WCHAR Key[GfvsKeyLength];
+
+    RtlZeroMemory (Key, sizeof(WCHAR) * GfvsKeyLength);
+
+    //
+    // Get the size of the File Version Info
+    //
+    Size = GetFileVersionInfoSize(pFileName, &Handle);
+
+    if (0 == Size)
+    {
+        RetVal = GetLastError();
+        return RetVal;
+    }
+
+    //
+    // Allocate memory for the File Version Info
+    //
+    pData = calloc(1, Size);
+
+    if (NULL == pData)
+    {
+        RetVal = ERROR_NOT_ENOUGH_MEMORY;  
+        goto Exit;
+    }        
+
+    //
+    // Get the File Version Info
+    //
+    Status = GetFileVersionInfo (
+        pFileName,
+        Handle,
+        Size,
+        pData
+        );
+
+    if (!Status)
+    {
+        RetVal = GetLastError();
+        goto Exit;
+    }
+
+    //
+    // Get language details
+    //
+    Status = VerQueryValue (
+        pData,
+        L"\\VarFileInfo\\Translation",
+        (PVOID *) & pTranslation,
+        & RequestedDataSize
+        );
+
+    if (!Status)
+    {        
+        RetVal = GetLastError();
+
+        //
+        // No VarFileInfo translation, assuming default language.
+        //
+        pTranslation = &DefaultLang;
+        RequestedDataSize = sizeof (DWORD);
+
+        //
+        // Ignore previous error
+        //        
+        RetVal = 0;
+    }
+
+    //
+    // Create the query string
+    //
+    RetVal = StringCchPrintf (
+        Key,
+        GfvsKeyLength,
+        L"\\StringFileInfo\\%04x%04x\\FileVersion",
+        LOWORD(*pTranslation), 
+        HIWORD(*pTranslation)
+        );
+
+    if (0 != RetVal)
+    {
+        goto Exit;
+    }
+
+    //
+    // Query the FileVersion
+    //
+    Status = VerQueryValue(
+        pData,
+        Key,
+        & pRequestedData,
+        & RequestedDataSize
+        );
+
+    if (!Status)
+    {
+        RetVal = GetLastError();
+        goto Exit;
+    }        
+
+    //
+    // Check to see that we have enough room
+    //
+    if (RequestedDataSize > sizeof(WCHAR) * BufferLengthInCharacters)
+    {
+        RetVal = ERROR_BUFFER_OVERFLOW;
+        goto Exit;
+    }
+
+    //
+    // Copy the requested data
+    //
+    RetVal = StringCchPrintf (
+        StringBuffer, 
+        BufferLengthInCharacters, 
+        (LPWSTR) pRequestedData
+        );
+
+Exit:
+    if (pData)
+    {
+        free (pData);
+    }
+    return RetVal;
+}
+
+HRESULT
+ParseCommandLine(
+    __in_ecount(argc) WCHAR const * const argv[],
+    DWORD argc,
+    __inout PCOMMAND_LINE_ARGS arguments
+    )
+{
+    HRESULT result = ERROR_SUCCESS;
+    DWORD i;
+
+    for(i=1; i<argc; ++i) {
+        if(argv[i][0]=='/' || argv[i][0]=='-') {
+            const WCHAR *arg = &argv[i][1];
+            if(_wcsicmp(arg, L"?") == 0 || _wcsicmp(arg, L"help") == 0 ) {
+                arguments->DisplayUsage = TRUE;
+            }
+            else if(_wcsicmp(arg, L"parsedump") == 0) {
+                if(i + 1 < argc){
+                     arguments->ParseDump = TRUE;
+                     arguments->FileName = (PWSTR )&argv[i+1][0];
+                     i++;
+                }
+            }
+            else if(_wcsicmp(arg, L"batch") == 0) {
+                if(i + 1 < argc){
+                     arguments->Batch = TRUE;
+                     arguments->BatchInput = (PWSTR )&argv[i+1][0];
+                     i++;
+                }
+            }
+            else if(_wcsicmp(arg, L"query") == 0) {
+                if(i + 1 < argc){
+                     //
+                     // Everything after the raw dump is the query.
+                     //
+                     arguments->Query = TRUE;
+                     arguments->FileName = (PWSTR )&argv[i+1][0];
+                     arguments->QueryArgs = &argv[i+2];
+                     arguments->QueryArgCount = argc - (i + 2);
+                     break;
+                }
+            }
+            else if(_wcsicmp(arg, L"diff") == 0) {
+                if(i + 2 < argc){
+                     arguments->Diff = TRUE;
+                     arguments->FileName = (PWSTR )&argv[i+1][0];
+                     arguments->DiffFileName = (PWSTR )&argv[i+2][0];
+                     i += 2;
+                }
+            }
+            else if(_wcsicmp(arg, L"delta") == 0) {
+                if(i + 1 < argc){
+                     arguments->DeltaFileName = (PWSTR )&argv[i+1][0];
+                     i++;
+                }
+            }
+            else if(_wcsicmp(arg, L"jobs") == 0) {
+                if(i + 1 < argc){
+                     arguments->BatchJobs = (UINT32)wcstoul(argv[i+1], NULL, 10);
+                     i++;
+                }
+            }
+            else if(_wcsicmp(arg, L"outdir") == 0) {
+                if(i + 1 < argc){
+                     arguments->OutputDirectory = (PWSTR )&argv[i+1][0];
+                     i++;
+                }
+            }
+            else if (_wcsicmp(arg, L"noapreg") == 0) {
+                arguments->DoNotParseAPREG = TRUE;
+            }
+            else if (_wcsicmp(arg, L"device") == 0) {                
+                if(wcscmp(argv[i+1], L"8994") == 0) {
+                    arguments->sharedIMEM = TRUE;
+                }
+                else if(wcscmp(argv[i+1], L"8916") == 0) {
+                    arguments->sharedIMEM = FALSE;
+                }
+                
+            }
+            else if (_wcsicmp(arg, L"apreg64") == 0)  {
+                arguments->apreg64 = TRUE;
+                 if(i + 1 < argc){
+                     arguments->apreg64TableAddr.QuadPart = _wcstoui64(argv[i+1], NULL, 16);                 
+                     i++;
+                }                
+            }
+            else if(_wcsicmp(arg, L"parsepart") == 0) {
+                arguments->PasePartition = TRUE;
+                arguments->DumpDDR = TRUE;
+            }
+            else if(_wcsicmp(arg, L"dumpddr") == 0) {
+                arguments->DumpDDR = TRUE;
+            }
+            else if(_wcsicmp(arg, L"checkdebug") == 0) {
+                arguments->CheckDebugPolicy = TRUE;
+            }
+            else if(_wcsicmp(arg, L"checkevent") == 0) {
+                arguments->CheckOfflineDumpEvent = TRUE;
+            }
+            else if(_wcsicmp(arg, L"checkeventUI") == 0) {
+                arguments->CheckOfflineDumpEventUI = TRUE;
+            } 
+            else if(_wcsicmp(arg, L"checkdump") == 0) {
+                arguments->CheckValidDump = TRUE;
+            }
+            else if(_wcsicmp(arg, L"wipedump") == 0) {
+                arguments->WipeRawDumpHeader = TRUE;
+            }  
+            else if(_wcsicmp(arg, L"createpart") == 0) {
+                arguments->CreatePart = TRUE;
+            }
+            else if(_wcsicmp(arg, L"dumprawpart") == 0) {
+                if(i + 1 < argc){
+                     arguments->DumpRawPartition = TRUE;
+                     arguments->FileName = (PWSTR )&argv[i+1][0];
+                     i++;
+                }
+            }
+            else if(_wcsicmp(arg, L"ParseWPdump") == 0) {
+                if(i + 1 < argc){
+                     arguments->ParseWPdump = TRUE;
+                     arguments->FileName = (PWSTR )&argv[i+1][0];
+                     i++;
+                }
+            }  
+            else if(_wcsicmp(arg, L"ddr2dmp") == 0) {
+                arguments->GenDMPFormDDR = TRUE;
+            } 
+            else if (_wcsicmp(arg, L"ddr") == 0) {
+                if (i + 2 < argc) {
+                    arguments->ddr[arguments->DDRCount].DDRBase.QuadPart = _wcstoui64(argv[i + 1], NULL, 16);
+                    arguments->ddr[arguments->DDRCount].DDRFileName = (PWSTR)&argv[i + 2][0];
+                    arguments->DDRCount++;
+                    i += 2;
+                }
+            }
+            else {
+                wprintf(L"Unexpected command line argument '%s'.\n", argv[i]);
+                result = E_INVALIDARG;
+                goto Exit;
+                }
+            }
+    }
+
+Exit:
+
+    return result;
+}
+
+VOID
+DumpGUID(
+    _In_ GUID*  Guid
+    )
+{
+    LogLibInfoPrintf(L"\t                GUID: {%08X-%04X-%04X-%02X%02X-%02X%02X%02X%02X%02X%02X}",
+                Guid->Data1, Guid->Data2, Guid->Data3,
+                Guid->Data4[0], Guid->Data4[1], Guid->Data4[2],
+                Guid->Data4[3], Guid->Data4[4], Guid->Data4[5],
+                Guid->Data4[6], Guid->Data4[7]);
+}
+
+BOOL
+IsBatchInputFile(
+    _In_ LPCWSTR FileName
+    )
+{
+    LPCWSTR extension = PathFindExtensionW(FileName);
+
+    return (_wcsicmp(extension, L".raw") == 0) || (_wcsicmp(extension, L".bin") == 0);
+}
+
+HRESULT
+CollectBatchInputs(
+    _In_    LPCWSTR BatchInput,
+    _Inout_ std::vector<std::wstring> &Inputs
+    )
+/*++
+
+Routine Description:
+
+    Builds the list of raw dumps to convert. BatchInput is either a directory,
+    searched (not recursively) for .RAW and .BIN files, or a manifest listing
+    one raw dump per line.
+
+Arguments:
+
+    BatchInput - Directory or manifest file
+    Inputs - Receives the raw dump paths
+
+Return Value:
+
+    HRESULT
+
+--*/
+{
+    HRESULT             result = S_OK;
+    DWORD               attributes;
+    WIN32_FIND_DATAW    findData;
+    HANDLE              hFind = INVALID_HANDLE_VALUE;
+    FILE                *manifest = NULL;
+    WCHAR               line[MAX_PATH + 2];
+    std::wstring        pattern;
+
+    attributes = GetFileAttributesW(BatchInput);
+    if (attributes == INVALID_FILE_ATTRIBUTES) {
+        result = HRESULT_FROM_WIN32(GetLastError());
+        goto Exit;
+    }
+
+    if (attributes & FILE_ATTRIBUTE_DIRECTORY) {
+        pattern = BatchInput;
+        pattern += L"\\*";
+
+        hFind = FindFirstFileW(pattern.c_str(), &findData);
+        if (hFind == INVALID_HANDLE_VALUE) {
+            result = HRESULT_FROM_WIN32(GetLastError());
+            goto Exit;
+        }
+
+        do {
+            if (!(findData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) && IsBatchInputFile(findData.cFileName)) {
+                Inputs.push_back(std::wstring(BatchInput) + L"\\" + findData.cFileName);
+            }
+        } while (FindNextFileW(hFind, &findData));
+
+        FindClose(hFind);
+    }
+    else {
+        if (_wfopen_s(&manifest, BatchInput, L"rt, ccs=UTF-8") != 0) {
+            result = E_FAIL;
+            goto Exit;
+        }
+
+        while (fgetws(line, ARRAYSIZE(line), manifest) != NULL) {
+            size_t length = wcslen(line);
+
+            while ((length > 0) && iswspace(line[length - 1])) {
+                line[--length] = L'\0';
+            }
+
+            if ((length == 0) || (line[0] == L'#')) {
+                continue;
+            }
+
+            Inputs.push_back(line);
+        }
+
+        fclose(manifest);
+    }
+
+Exit:
+    return result;
+}
+
+VOID
+RunBatchJob(
+    _Inout_ PBATCH_JOB Job,
+    _In_    PCOMMAND_LINE_ARGS Arguments,
+    _In_    LARGE_INTEGER Frequency
+    )
+/*++
+
+Routine Description:
+
+    Converts one raw dump with a DMP_CONTEXT of its own, the same way
+    /parsedump does, writing the output files to the job's folder.
+
+Arguments:
+
+    Job - The raw dump to convert, receives the result
+    Arguments - Parsed command line, for the options that apply to each dump
+    Frequency - Performance counter frequency
+
+Return Value:
+
+    None
+
+--*/
+{
+    DMP_CONTEXT                 context = { 0 };
+    LARGE_INTEGER               start;
+    LARGE_INTEGER               end;
+    WIN32_FILE_ATTRIBUTE_DATA   attributes;
+
+    context.HasValidAP_REG = TRUE;
+    context.IsAPREGRequested = TRUE;
+    context.DedicatedDumpHandle = INVALID_HANDLE_VALUE;
+    context.DumpDDR = Arguments->DumpDDR;
+    context.OutputDirectory = Job->OutputDirectory.c_str();
+
+    if (Arguments->apreg64 == TRUE) {
+        context.isAPREG64 = TRUE;
+        context.APRegAddress.QuadPart = Arguments->apreg64TableAddr.QuadPart;
+    }
+
+    if (Arguments->DoNotParseAPREG == TRUE) {
+        context.IsAPREGRequested = FALSE;
+        context.isAPREG64 = FALSE;
+    }
+
+    if (GetFileAttributesExW(Job->InputPath.c_str(), GetFileExInfoStandard, &attributes)) {
+        Job->InputSize = ((ULONGLONG)attributes.nFileSizeHigh << 32) | attributes.nFileSizeLow;
+    }
+
+    LogLibInfoPrintf(L"Batch: converting %s into %s", Job->InputPath.c_str(), Job->OutputDirectory.c_str());
+
+    QueryPerformanceCounter(&start);
+    if (!CreateDirectoryW(Job->OutputDirectory.c_str(), NULL) && (GetLastError() != ERROR_ALREADY_EXISTS)) {
+        Job->Status = STATUS_OBJECT_PATH_NOT_FOUND;
+    }
+    else {
+        Job->Status = ExtractRawDumpFileToFiles(&context, Job->InputPath.c_str());
+    }
+    QueryPerformanceCounter(&end);
+
+    Job->ElapsedMs = (ULONGLONG)((end.QuadPart - start.QuadPart) * 1000 / Frequency.QuadPart);
+    Job->Is64Bit = context.Is64Bit;
+    Job->BugCheckCode = context.BugCheckCode;
+
+    FreeDumpContext(&context);
+}
+
+DWORD
+WINAPI
+BatchWorker(
+    _In_ LPVOID Parameter
+    )
+{
+    PBATCH_CONTEXT  batch = (PBATCH_CONTEXT)Parameter;
+    LONG            index;
+
+    while ((index = InterlockedIncrement(&batch->NextJob) - 1) < (LONG)batch->Jobs.size()) {
+        RunBatchJob(&batch->Jobs[index], batch->Arguments, batch->Frequency);
+    }
+
+    return 0;
+}
+
+HRESULT
+RunBatch(
+    _In_ PCOMMAND_LINE_ARGS Arguments
+    )
+/*++
+
+Routine Description:
+
+    Converts every raw dump of a directory or manifest on a bounded pool of
+    worker threads, then prints one row per dump with its result and timing.
+
+    Everything up to the writing of raw_dump.dmp runs in parallel. dbgeng
+    keeps one session per process, so the part of each conversion that needs
+    it is serialized by DbgClient.
+
+Arguments:
+
+    Arguments - Parsed command line
+
+Return Value:
+
+    S_OK if every dump was converted.
+
+--*/
+{
+    HRESULT                     result = S_OK;
+    BATCH_CONTEXT               batch;
+    std::vector<std::wstring>   inputs;
+    std::wstring                outputRoot;
+    HANDLE                      workers[MAX_BATCH_JOBS];
+    UINT32                      workerCount = 0;
+    UINT32                      jobCount;
+    UINT32                      failed = 0;
+    SYSTEM_INFO                 sysInfo;
+    LARGE_INTEGER               start;
+    LARGE_INTEGER               end;
+    ULONGLONG                   elapsedMs;
+    WCHAR                       currentDirectory[MAX_PATH];
+
+    batch.NextJob = 0;
+    batch.Arguments = Arguments;
+    QueryPerformanceFrequency(&batch.Frequency);
+
+    result = CollectBatchInputs(Arguments->BatchInput, inputs);
+    if (FAILED(result)) {
+        LogLibErrorPrintf(
+            result,
+            __LINE__,
+            WIDEN(__FUNCTION__),
+            __WFILE__,
+            L"Error: Cannot read the batch input %s\n",
+            Arguments->BatchInput);
+        goto Exit;
+    }
+
+    if (inputs.empty()) {
+        LogLibInfoPrintf(L"Batch: no raw dumps found in %s", Arguments->BatchInput);
+        goto Exit;
+    }
+
+    if (Arguments->OutputDirectory != NULL) {
+        outputRoot = Arguments->OutputDirectory;
+        CreateDirectoryW(outputRoot.c_str(), NULL);
+    }
+    else if (GetCurrentDirectoryW(ARRAYSIZE(currentDirectory), currentDirectory) != 0) {
+        outputRoot = currentDirectory;
+    }
+    else {
+        outputRoot = L".";
+    }
+
+    //
+    // Each dump gets a folder named after it, suffixed with its index when
+    // two inputs share a name.
+    //
+    for (size_t index = 0; index < inputs.size(); index++) {
+        BATCH_JOB       job = { };
+        std::wstring    name = PathFindFileNameW(inputs[index].c_str());
+
+        name = name.substr(0, name.find_last_of(L'.'));
+        for (size_t other = 0; other < index; other++) {
+            if (_wcsicmp(PathFindFileNameW(inputs[other].c_str()), PathFindFileNameW(inputs[index].c_str())) == 0) {
+                name += L"_" + std::to_wstring((ULONGLONG)index);
+                break;
+            }
+        }
+
+        job.InputPath = inputs[index];
+        job.OutputDirectory = outputRoot + L"\\" + name;
+        job.Status = STATUS_UNSUCCESSFUL;
+        batch.Jobs.push_back(job);
+    }
+
+    jobCount = Arguments->BatchJobs;
+    if (jobCount == 0) {
+        GetSystemInfo(&sysInfo);
+        jobCount = sysInfo.dwNumberOfProcessors;
+    }
+
+    jobCount = min(jobCount, (UINT32)MAX_BATCH_JOBS);
+    jobCount = min(jobCount, (UINT32)batch.Jobs.size());
+
+    LogLibInfoPrintf(L"Batch: %u raw dumps, %u workers, output in %s", (UINT32)batch.Jobs.size(), jobCount, outputRoot.c_str());
+
+    QueryPerformanceCounter(&start);
+    for (workerCount = 0; workerCount < jobCount; workerCount++) {
+        workers[workerCount] = CreateThread(NULL, 0, BatchWorker, &batch, 0, NULL);
+        if (workers[workerCount] == NULL) {
+            break;
+        }
+    }
+
+    if (workerCount == 0) {
+        //
+        // No thread could be created, convert on this one.
+        //
+        BatchWorker(&batch);
+    }
+    else {
+        WaitForMultipleObjects(workerCount, workers, TRUE, INFINITE);
+        for (UINT32 index = 0; index < workerCount; index++) {
+            CloseHandle(workers[index]);
+        }
+    }
+    QueryPerformanceCounter(&end);
+    elapsedMs = (ULONGLONG)((end.QuadPart - start.QuadPart) * 1000 / batch.Frequency.QuadPart);
+
+    //
+    // Result table.
+    //
+    wprintf(L"\n%5s  %-10s  %-5s  %-10s  %10s  %10s  %8s  %s\n",
+            L"#", L"Status", L"Arch", L"BugCheck", L"Size (MB)", L"Time (ms)", L"MB/s", L"Raw dump");
+    for (size_t index = 0; index < batch.Jobs.size(); index++) {
+        PBATCH_JOB  job = &batch.Jobs[index];
+        ULONGLONG   sizeMB = job->InputSize / SIZE_1MB;
+        ULONGLONG   rate = (job->ElapsedMs > 0) ? (job->InputSize * 1000 / SIZE_1MB / job->ElapsedMs) : 0;
+
+        if (!NT_SUCCESS(job->Status)) {
+            failed++;
+        }
+
+        wprintf(L"%5u  0x%08x  %-5s  0x%08x  %10I64u  %10I64u  %8I64u  %s\n",
+                (UINT32)index, job->Status, job->Is64Bit ? L"64" : L"32", job->BugCheckCode,
+                sizeMB, job->ElapsedMs, rate, job->InputPath.c_str());
+        LogLibInfoPrintf(L"Batch result: %u status 0x%08x bugcheck 0x%08x %I64u MB %I64u ms %s",
+                (UINT32)index, job->Status, job->BugCheckCode, sizeMB, job->ElapsedMs, job->InputPath.c_str());
+    }
+
+    wprintf(L"\nConverted %u of %u raw dumps in %I64u ms with %u workers.\n",
+            (UINT32)batch.Jobs.size() - failed, (UINT32)batch.Jobs.size(), elapsedMs, max(workerCount, (UINT32)1));
+
+    if (failed != 0) {
+        result = E_FAIL;
+    }
+
+Exit:
+    return result;
+}
+
+int __cdecl
+wmain (
+    DWORD argc,
+    __in_ecount(argc) WCHAR const * const argv[]
+    )
+{
+    HANDLE hVol = NULL;
+    LPWSTR logName = L"OfflineDumpTool.wtl";
+    HRESULT result = ERROR_SUCCESS;
+    DMP_CONTEXT context = { 0 };
+    NTSTATUS status = STATUS_SUCCESS;
+    WCHAR ProgramFileVersion[MAX_PATH];
+    COMMAND_LINE_ARGS CommandLineArgs = { 0 };
+    DWORD FileVersion = 0;
+
+    //
+    // Init the Context 
+    //
+    context.HasValidAP_REG = TRUE;
+    context.IsAPREGRequested = TRUE;
+    context.DedicatedDumpHandle = INVALID_HANDLE_VALUE;
+
+    LogLibCreateLog(logName);
+    
+#if 0
+    LogLibInfoPrintf(L"\n====PRIVATE BUILD. PLEASE DO NOT DISTRIBUTE====\n");
+#endif
+    
+    FileVersion = GetFileVersionString(
+                    NAME_EXECUTABLE,
+                    ProgramFileVersion,
+                    MAX_PATH
+                    );
+    if( FileVersion == 0)
+    {
+        LogLibInfoPrintf(L"\n====Offline Dump Tool Version = %s====\n", ProgramFileVersion);
+    }
+    else
+    {
+        LogLibInfoPrintf(L"Version unavailable");
+    }
+
+    LogLibLogMachineInfo();
+   
+    // Start the COM interface.
+    //
+    result = CoInitializeEx( NULL, COINIT_MULTITHREADED );
+    result = CoInitializeSecurity(NULL,
+                              -1,
+                              NULL,
+                              NULL,
+                              RPC_C_AUTHN_LEVEL_CONNECT,
+                              RPC_C_IMP_LEVEL_IMPERSONATE,
+                              NULL,
+                              0,
+                              NULL);
+
+    if (FAILED(result))  {
+        LogLibInfoPrintf(L"Failed to coinitialize");
+    }
+    
+    result = ParseCommandLine(argv, argc, &CommandLineArgs);
+    if(result != ERROR_SUCCESS) {
+        goto Exit;
+    }    
+
+    if(CommandLineArgs.DisplayUsage == TRUE || argc == 1 ) {
+        Usage();
+        goto Exit;
+    }
+    
+    if (CommandLineArgs.sharedIMEM == TRUE) {
+        LogLibStartTest(L"Shared IMEM is different than IMEM BASE\n");
+        g_Shared_IMEM = TRUE;
+    }
+    
+    if (CommandLineArgs.apreg64 == TRUE) {
+        LogLibStartTest(L"64 bit APREG format is chosen\n");
+        context.isAPREG64 = TRUE;
+        context.APRegAddress.QuadPart = CommandLineArgs.apreg64TableAddr.QuadPart;
+        wprintf(L"context.APRegAddress.QuadPart: 0x%I64x\n", context.APRegAddress.QuadPart);       
+    }
+    
+    if( CommandLineArgs.DoNotParseAPREG == TRUE) {
+        LogLibStartTest(L"APREG update is not requested \n");
+        context.IsAPREGRequested = FALSE;
+        context.isAPREG64 = FALSE;            
+    }  
+    
+    if (CommandLineArgs.Batch == TRUE) {
+        LogLibStartTest(L"Convert a batch of raw dumps\n");
+        result = RunBatch(&CommandLineArgs);
+        if (FAILED(result)) {
+            LogLibErrorPrintf(
+                result,
+                __LINE__,
+                WIDEN(__FUNCTION__),
+                __WFILE__,
+                L"Error: One or more raw dumps of the batch failed to convert\n");
+        }
+        LogLibEndTest(L"Convert a batch of raw dumps\n");
+        goto Exit;
+    }
+
+    if (CommandLineArgs.Query == TRUE) {
+        result = RunQuery(&context, CommandLineArgs.FileName, CommandLineArgs.QueryArgCount, CommandLineArgs.QueryArgs);
+        goto Exit;
+    }
+
+    if (CommandLineArgs.Diff == TRUE) {
+        LogLibStartTest(L"Compare two raw dumps\n");
+        result = DiffRawDumps(CommandLineArgs.FileName, CommandLineArgs.DiffFileName, CommandLineArgs.DeltaFileName, CommandLineArgs.BatchJobs);
+        if (FAILED(result)) {
+            LogLibErrorPrintf(
+                result,
+                __LINE__,
+                WIDEN(__FUNCTION__),
+                __WFILE__,
+                L"Error: Failed to compare the raw dumps\n");
+        }
+        LogLibEndTest(L"Compare two raw dumps\n");
+        goto Exit;
+    }
+
+    if (CommandLineArgs.CheckDebugPolicy == TRUE) {
+          LogLibStartTest(L"Checking if the Device Debug policy is enabled or not\n");
+          if( CheckDebugPolicyEnabled())  {
+               LogLibInfoPrintf(L"The machine debug policy is enabled");
+          }
+          else {
+               LogLibErrorPrintf(
+                result,
+                __LINE__,
+                WIDEN(__FUNCTION__),
+                __WFILE__, 
+                L"Error: Debug Policy is not enabled. This device cannot use the offline ram dump feature");
+          }
+          LogLibEndTest(L"Checking if the Device Debug policy is enabled or not\n");
+    }
+    if (CommandLineArgs.CheckOfflineDumpEvent == TRUE) {
+          LogLibStartTest(L"Check Abnormal Reset Event\n");
+          if( QueryAbnromalResetEvents())  {
+               LogLibInfoPrintf(L"there is an abnormal reset event");
+          }
+          else {
+               LogLibErrorPrintf(
+                result,
+                __LINE__,
+                WIDEN(__FUNCTION__),
+                __WFILE__, 
+                L"Error: not Found the Abnormal Reset Event");
+          }
+          LogLibEndTest(L"Check Abnormal Reset Event\n");
+    }
+    else if (CommandLineArgs.CheckOfflineDumpEventUI == TRUE) {
+          if( QueryAbnromalResetEvents())  {
+               MessageBox(NULL, 
+                          L"Oh! Your machine just hit a hard hang!\r\n Please run offline dump collection script on the desk to collect the dump then send a mail to platform support alias!",
+                          NULL,
+                          MB_OK);
+            }
+    }
+    else if (CommandLineArgs.CheckValidDump == TRUE) {
+          if( ExistValidOfflineDump(&context))  {
+               MessageBox(NULL, 
+                          L"Oh! Your machine just hit a hard hang!\r\n Please run offline dump collection script on the desk to collect the dump then send a mail to platform support alias!",
+                          NULL,
+                          MB_OK);
+            }
+    }
+    else if (CommandLineArgs.WipeRawDumpHeader == TRUE) {
+          if(!WipeRawDumpHeader(&context))  {
+              result = 1; 
+            }
+    }
+    else if( CommandLineArgs.ParseDump == TRUE) {        
+        LogLibStartTest(L"Read and Parse offline Dump from File\n");
+        if(CommandLineArgs.DumpDDR == TRUE) {
+            context.DumpDDR = TRUE;
+            LogLibInfoPrintf(L"Will Dump DDR sections to files");
+         }
+        LogLibInfoPrintf(L"Read from File %s", CommandLineArgs.FileName);
+        status = ExtractRawDumpFileToFiles(&context, CommandLineArgs.FileName);
+        if (!NT_SUCCESS(status)) {
+            LogLibErrorPrintf(
+                result,
+                __LINE__,
+                WIDEN(__FUNCTION__),
+                __WFILE__, 
+                L"Error: ReadDumpFromFile Failed : %d\n",
+                GetLastError());
+        }
+        LogLibEndTest(L"Read and Parse offline Dump from File\n");
+    }
+     else if( CommandLineArgs.PasePartition == TRUE) {
+         LogLibStartTest(L"Extract Raw_Dump Partition To Windows Dump and Silicon Bin Files\n");
+         if(CommandLineArgs.DumpDDR == TRUE) {
+            context.DumpDDR = TRUE;
+            LogLibInfoPrintf(L"Will Dump DDR sections to files");
+         }
+         status = ExtractRawDumpPartitionToFiles(&context);
+          if(!NT_SUCCESS(status)) {
+            result = E_FAIL;
+            LogLibErrorPrintf(
+                result,
+                __LINE__,
+                WIDEN(__FUNCTION__),
+                __WFILE__, 
+                L"Error: ExtractRawDumpPartitionToFiles Failed : %d\n",
+                GetLastError());
+            }
+          LogLibEndTest(L"Extract Raw_Dump Partition To Windows Dump and Silicon Bin Files\n");
+    } 
+     else if( CommandLineArgs.CreatePart == TRUE) {
+        LogLibStartTest(L"Create Raw_Dump Partition\n");
+        hVol = CreateGPTRawDumpPartition();
+        if(INVALID_HANDLE_VALUE == hVol) {
+            result = E_FAIL;
+            LogLibErrorPrintf(
+                result,
+                __LINE__,
+                WIDEN(__FUNCTION__),
+                __WFILE__, 
+                L"Error: Create Raw Dump Parition Failed : %d\n",
+                GetLastError());
+        }
+        LogLibEndTest(L"Create Raw_Dump Partition\n");
+    }
+    else if( CommandLineArgs.ParseWPdump == TRUE) {
+        LogLibStartTest(L"Parse Windows Phone Dump File to Extract SV bins \n");
+        result = ExtractSecondaryDataFromDumpFile(CommandLineArgs.FileName);
+        if(FAILED(result)) {
+            result = E_FAIL;
+            LogLibErrorPrintf(
+                result,
+                __LINE__,
+                WIDEN(__FUNCTION__),
+                __WFILE__, 
+                L"Error: Parse Windows Phone Dump File and Extract SV bins  Failed : %d\n",
+                GetLastError());
+        }
+        LogLibEndTest(L"Parse Windows Phone Dump File to Extract SV bins \n");
+
+        LogLibStartTest(L"Parse Windows Phone Dump File to reconstruct DDR bins \n");
+        result = ReconstructDDRSectionsFromDumpFile(CommandLineArgs.FileName);
+        if(FAILED(result)) {
+            result = E_FAIL;
+            LogLibErrorPrintf(
+                result,
+                __LINE__,
+                WIDEN(__FUNCTION__),
+                __WFILE__, 
+                L"Error: Parse Windows Phone Dump File and reconstruct DDR bins  Failed : %d\n",
+                GetLastError());
+        }
+        LogLibEndTest(L"Parse Windows Phone Dump File to reconstruct DDR bins bins \n");
+    }
+    else if( CommandLineArgs.GenDMPFormDDR == TRUE) {
+        LogLibStartTest(L"Try Carve Windows Dump File from DDR Sections \n");     
+        if(!OpenDDRFiles(&context, &CommandLineArgs)) {
+            LogLibErrorPrintf(
+                E_FAIL,
+                __LINE__,
+                WIDEN(__FUNCTION__),
+                __WFILE__, 
+                L"Error:  Failed to open the DDR section files\n");
+       } 
+       else
+       {
+           // now need process thie dump file now.
+            result = ExtractWindowsDumpFromDDR(&context, nullptr);
+            if(FAILED(result)) {
+                result = E_FAIL;
+                LogLibErrorPrintf(
+                    result,
+                    __LINE__,
+                    WIDEN(__FUNCTION__),
+                    __WFILE__, 
+                    L"Error:  Carving the Windows Dump file from the DDR Sections  Failed : %d\n",
+                    GetLastError());
+            }
+       }
+       
+       LogLibEndTest(L"Try Carve Windows Dump File from DDR Sections \n");
+    }
+
+    else if( CommandLineArgs.DumpRawPartition == TRUE) {
+        LogLibStartTest(L"Directly extracting Raw_Dump Partition to a single file\n");
+        status = FindDumpPartition(&context);
+        if (status != ERROR_SUCCESS){
+            // The script that wraps this tool expects the tool to return postive value for failure.
+            result = 1;    
+            LogLibErrorPrintf(
+                                E_FAIL,
+                                __LINE__,
+                                WIDEN(__FUNCTION__),
+                                __WFILE__, 
+                                L"Error: Locating the RAW_Dump Partition  failed : %d\n",
+                                GetLastError());
+        }
+        else {
+            if(!ReadRawDumpPartitionToFile(&context,
+                                    CommandLineArgs.FileName )) {
+                // The script that wraps this tool expects the tool to return postive value for failure.
+                result = 2;
+                LogLibErrorPrintf(
+                                E_FAIL,
+                                __LINE__,
+                                WIDEN(__FUNCTION__),
+                                __WFILE__, 
+                                L"Error: Extracting from the RAW_Dump partition failed : %d\n",
+                                GetLastError());
+            }
+         }
+         LogLibEndTest(L"Directly extract Raw_Dump Partition to single file\n");
+    }
+
+Exit:
+    
+    CoUninitialize();
+
+    FreeDumpContext(&context);
+
+    LogLibCloseLog();
+    
+    return result;
+}
+
+
+
@@ -0,0 +1,864 @@
+/*++
+
+    Copyright (C) Microsoft. All rights reserved.
+
+Module Name:
+   Query.cpp
+
+Abstract:
+   Random access to the memory of a raw dump without converting it. The raw
+   dump is opened in place, its DDR ranges come from the raw2dump sidecar
+   index (<raw dump>.r2dx) when there is one for this raw dump, or else from
+   the section table, and each query reads only the pages it needs.
+
+   Physical reads, virtual reads and page table walks are supported for
+   ARM64 (4 levels, 1 GB and 2 MB blocks) and for 32-bit non-PAE tables
+   (2 levels, 4 MB sections); x64 and PAE tables are reported as not
+   supported. The directory table base comes from the index,
+   from a scan of the raw dump for the DUMP_HEADER, or from the user. The
+   index does not record PAE, for 32-bit tables it is read from the
+   DUMP_HEADER the index points at.
+
+Environment:
+   User Mode
+
+--*/
+#include "common.h"
+#include "DumpUtil.h"
+#include "RawDumpIndex.h"
+
+#define QUERY_MAX_LINE                  512
+#define QUERY_MAX_TOKENS                8
+#define QUERY_DEFAULT_LENGTH            0x80
+#define QUERY_MAX_LENGTH                0x100000
+#define QUERY_BYTES_PER_LINE            16
+
+#define ARM_PDE_SHIFT                   22
+#define ARM_PTE_SHIFT                   12
+#define ARM_PTE_MASK                    0x3ff
+#define ARM_LARGE_PAGE_SIZE             (4 * 1024 * 1024)
+
+typedef struct _QUERY_SESSION
+{
+    PDMP_CONTEXT            Context;
+    BOOL                    IndexLoaded;
+    RAW_DUMP_INDEX_HEADER   Index;
+
+    //
+    // Page tables used to translate virtual addresses.
+    //
+    BOOL                    Is64Bit;
+    BOOL                    PaeEnabled;
+    BOOL                    Amd64;                  // x64 page tables, not supported
+    UINT64                  DirectoryTableBase;
+} QUERY_SESSION, *PQUERY_SESSION;
+
+
+static
+BOOL
+ParseQueryNumber(
+    _In_ LPCWSTR Token,
+    _Out_ PUINT64 Value
+    )
+/*++
+
+Routine Description:
+
+    Parses a hex number, with or without 0x. The debugger's ` separator of
+    64-bit addresses is allowed.
+
+--*/
+{
+    WCHAR   digits[32];
+    WCHAR*  end = nullptr;
+    size_t  count = 0;
+
+    for (; (*Token != L'\0') && (count < ARRAYSIZE(digits) - 1); Token++) {
+        if (*Token != L'`') {
+            digits[count++] = *Token;
+        }
+    }
+
+    digits[count] = L'\0';
+    if ((count == 0) || (*Token != L'\0')) {
+        return FALSE;
+    }
+
+    *Value = _wcstoui64(digits, &end, 16);
+    return (*end == L'\0');
+}
+
+
+static
+VOID
+PrintQueryBytes(
+    _In_ UINT64 Address,
+    _In_reads_bytes_(Length) const UCHAR* Buffer,
+    _In_ SIZE_T Length
+    )
+{
+    SIZE_T  line;
+    SIZE_T  index;
+
+    for (line = 0; line < Length; line += QUERY_BYTES_PER_LINE) {
+        wprintf(L"%016I64x ", Address + line);
+        for (index = 0; index < QUERY_BYTES_PER_LINE; index++) {
+            if (line + index < Length) {
+                wprintf(L"%c%02x", (index == QUERY_BYTES_PER_LINE / 2) ? L'-' : L' ', Buffer[line + index]);
+            }
+            else {
+                wprintf(L"   ");
+            }
+        }
+
+        wprintf(L"  ");
+        for (index = 0; (index < QUERY_BYTES_PER_LINE) && (line + index < Length); index++) {
+            UCHAR c = Buffer[line + index];
+            wprintf(L"%c", ((c >= 0x20) && (c < 0x7f)) ? (WCHAR)c : L'.');
+        }
+
+        wprintf(L"\n");
+    }
+}
+
+
+static
+BOOL
+ReadQueryPaeEnabled(
+    _Inout_ PQUERY_SESSION Session,
+    _In_ UINT64 DumpHeaderPA
+    )
+/*++
+
+Routine Description:
+
+    Sets PaeEnabled from the 32-bit DUMP_HEADER at DumpHeaderPA. The DDR
+    memory map must have been built.
+
+Return Value:
+
+    TRUE if a valid DUMP_HEADER was read.
+
+--*/
+{
+    DUMP_HEADER32   dumpHeader;
+    LARGE_INTEGER   physicalAddress;
+
+    physicalAddress.QuadPart = (LONGLONG)DumpHeaderPA;
+    if ((DumpHeaderPA == 0) ||
+        !NT_SUCCESS(ReadFromDDRSectionByPhysicalAddress(Session->Context, physicalAddress, sizeof(dumpHeader), &dumpHeader)) ||
+        (dumpHeader.Signature != DUMP_SIGNATURE32) ||
+        (dumpHeader.ValidDump != DUMP_VALID_DUMP32)) {
+        return FALSE;
+    }
+
+    Session->PaeEnabled = (dumpHeader.PaeEnabled != FALSE);
+    return TRUE;
+}
+
+
+static
+BOOL
+LoadQueryIndex(
+    _Inout_ PQUERY_SESSION Session
+    )
+/*++
+
+Routine Description:
+
+    Loads the raw2dump sidecar index of the raw dump, which builds the DDR
+    memory map, and takes the bitness and the directory table base from it.
+
+    32-bit page tables may be PAE ones, which the index does not say. The
+    directory table base is only taken when PAE could be read from the
+    DUMP_HEADER, otherwise scan has to find it.
+
+Arguments:
+
+    Session - Query session
+
+Return Value:
+
+    TRUE if the index was loaded.
+
+--*/
+{
+    PRAW_DUMP_INDEX_HEADER  header = &Session->Index;
+
+    if (!LoadRawDumpIndex(Session->Context, header)) {
+        return FALSE;
+    }
+
+    Session->IndexLoaded = TRUE;
+    if ((header->DirectoryTableBase != 0) &&
+        ((header->Is64Bit != 0) || ReadQueryPaeEnabled(Session, header->DumpHeaderPA))) {
+        Session->Is64Bit = (header->Is64Bit != 0);
+        Session->DirectoryTableBase = header->DirectoryTableBase;
+    }
+
+    return TRUE;
+}
+
+
+static
+NTSTATUS
+ReadQueryEntry(
+    _In_ PQUERY_SESSION Session,
+    _In_ UINT64 Address,
+    _In_ BOOL Verbose,
+    _In_z_ LPCWSTR Level,
+    _Out_ PUINT64 Entry
+    )
+{
+    LARGE_INTEGER   physicalAddress;
+    UINT32          entry32 = 0;
+    NTSTATUS        status;
+
+    physicalAddress.QuadPart = (LONGLONG)Address;
+    *Entry = 0;
+
+    if (Session->Is64Bit) {
+        status = ReadFromDDRSectionByPhysicalAddress(Session->Context, physicalAddress, sizeof(UINT64), Entry);
+    }
+    else {
+        status = ReadFromDDRSectionByPhysicalAddress(Session->Context, physicalAddress, sizeof(UINT32), &entry32);
+        *Entry = entry32;
+    }
+
+    if (!NT_SUCCESS(status)) {
+        wprintf(L"  %-4s at %016I64x is not in the DDR ranges\n", Level, Address);
+    }
+    else if (Verbose) {
+        wprintf(L"  %-4s at %016I64x contains %016I64x\n", Level, Address, *Entry);
+    }
+
+    return status;
+}
+
+
+static
+NTSTATUS
+TranslateQueryAddress(
+    _In_ PQUERY_SESSION Session,
+    _In_ UINT64 VirtualAddress,
+    _In_ BOOL Verbose,
+    _Out_ PUINT64 PhysicalAddress,
+    _Out_ PUINT64 PageSize
+    )
+/*++
+
+Routine Description:
+
+    Walks the page tables of the session for one virtual address. With
+    Verbose set each level is printed.
+
+Arguments:
+
+    Session - Query session
+
+    VirtualAddress - Address to translate
+
+    Verbose - Print the entry read at each level
+
+    PhysicalAddress - Receives the physical address
+
+    PageSize - Receives the size of the page or block that maps it
+
+Return Value:
+
+    NT status code. STATUS_NOT_FOUND if the address is not mapped.
+
+--*/
+{
+    UINT64      directoryTableBase;
+    UINT64      entry = 0;
+    UINT64      upper;
+    NTSTATUS    status = STATUS_UNSUCCESSFUL;
+
+    *PhysicalAddress = ADDRESS_NOT_PRESENT;
+    *PageSize = PAGE_SIZE;
+
+    if (Session->DirectoryTableBase == 0) {
+        wprintf(L"No directory table base, use dtb or scan first\n");
+        status = STATUS_INVALID_PARAMETER;
+        goto Exit;
+    }
+
+    if (Session->Amd64) {
+        wprintf(L"x64 page tables are not supported, use pa\n");
+        status = STATUS_NOT_SUPPORTED;
+        goto Exit;
+    }
+
+    if (Session->Is64Bit) {
+        directoryTableBase = Session->DirectoryTableBase & ARM64_VALID_PFN_MASK;
+
+        //
+        // Only the low 48 bits are used, the rest must be a sign extension.
+        //
+        upper = VirtualAddress >> ARM64_USED_VA_BITS;
+        if (((VirtualAddress & (1UI64 << (ARM64_USED_VA_BITS - 1))) != 0) ? (upper != ARM64_UNUSED_VA_MASK) : (upper != 0)) {
+            wprintf(L"%016I64x is not a canonical address\n", VirtualAddress);
+            status = STATUS_INVALID_PARAMETER;
+            goto Exit;
+        }
+
+        status = ReadQueryEntry(Session,
+                                directoryTableBase + ((VirtualAddress >> ARM64_PML4E_SHIFT) & ARM64_PML4E_MASK) * sizeof(UINT64),
+                                Verbose,
+                                L"PXE",
+                                &entry);
+        if (!NT_SUCCESS(status)) {
+            goto Exit;
+        }
+
+        if (!((PARM64_HARDWARE_PTE)&entry)->Valid) {
+            status = STATUS_NOT_FOUND;
+            goto Exit;
+        }
+
+        status = ReadQueryEntry(Session,
+                                (entry & ARM64_VALID_PFN_MASK) + ((VirtualAddress >> ARM64_PDPE_SHIFT) & ARM64_PDPE_MASK) * sizeof(UINT64),
+                                Verbose,
+                                L"PPE",
+                                &entry);
+        if (!NT_SUCCESS(status)) {
+            goto Exit;
+        }
+
+        if (!((PARM64_HARDWARE_PTE)&entry)->Valid) {
+            status = STATUS_NOT_FOUND;
+            goto Exit;
+        }
+
+        if (!((PARM64_HARDWARE_PTE)&entry)->NotLargePage) {
+            *PhysicalAddress = (entry & ARM64_1GB_PPE_PAGE_MASK) + (VirtualAddress & ARM64_1GB_PPE_ADDR_OFFSET_MASK);
+            *PageSize = ARM64_1GB_PAGE_SIZE;
+            goto Exit;
+        }
+
+        status = ReadQueryEntry(Session,
+                                (entry & ARM64_VALID_PFN_MASK) + ((VirtualAddress >> ARM64_PDE_SHIFT) & ARM64_PDE_MASK) * sizeof(UINT64),
+                                Verbose,
+                                L"PDE",
+                                &entry);
+        if (!NT_SUCCESS(status)) {
+            goto Exit;
+        }
+
+        if (!((PARM64_HARDWARE_PTE)&entry)->Valid) {
+            status = STATUS_NOT_FOUND;
+            goto Exit;
+        }
+
+        if (!((PARM64_HARDWARE_PTE)&entry)->NotLargePage) {
+            *PhysicalAddress = (entry & ARM64_LARGE_PAGE_PDE_MASK) + (VirtualAddress & ARM64_LARGE_PAGE_ADDR_OFFSET_MASK);
+            *PageSize = ARM64_LARGE_PAGE_SIZE;
+            goto Exit;
+        }
+
+        status = ReadQueryEntry(Session,
+                                (entry & ARM64_VALID_PFN_MASK) + ((VirtualAddress >> ARM64_PTE_SHIFT) & ARM64_PTE_MASK) * sizeof(UINT64),
+                                Verbose,
+                                L"PTE",
+                                &entry);
+        if (!NT_SUCCESS(status)) {
+            goto Exit;
+        }
+
+        if (!((PARM64_HARDWARE_PTE)&entry)->Valid) {
+            status = STATUS_NOT_FOUND;
+            goto Exit;
+        }
+
+        *PhysicalAddress = (entry & ARM64_VALID_PFN_MASK) + (VirtualAddress & ARM64_OFFSET_WITHIN_PAGE_MASK);
+    }
+    else {
+        if (Session->PaeEnabled) {
+            wprintf(L"PAE page tables are not supported, use pa\n");
+            status = STATUS_NOT_SUPPORTED;
+            goto Exit;
+        }
+
+        if (VirtualAddress > MAXULONG) {
+            wprintf(L"%016I64x is not a 32-bit address\n", VirtualAddress);
+            status = STATUS_INVALID_PARAMETER;
+            goto Exit;
+        }
+
+        directoryTableBase = Session->DirectoryTableBase & ARM_VALID_PFN_MASK;
+        status = ReadQueryEntry(Session,
+                                directoryTableBase + (VirtualAddress >> ARM_PDE_SHIFT) * sizeof(UINT32),
+                                Verbose,
+                                L"PDE",
+                                &entry);
+        if (!NT_SUCCESS(status)) {
+            goto Exit;
+        }
+
+        if (((PHARDWARE_PTE)&entry)->Valid == 0) {
+            status = STATUS_NOT_FOUND;
+            goto Exit;
+        }
+
+        if (((PHARDWARE_PTE)&entry)->LargePage) {
+            *PhysicalAddress = (entry & ARM_PDE_MASK) + (VirtualAddress & ARM_LARGE_PAGE_ADDR_OFFSET_MASK);
+            *PageSize = ARM_LARGE_PAGE_SIZE;
+            goto Exit;
+        }
+
+        status = ReadQueryEntry(Session,
+                                (entry & ARM_VALID_PFN_MASK) + ((VirtualAddress >> ARM_PTE_SHIFT) & ARM_PTE_MASK) * sizeof(UINT32),
+                                Verbose,
+                                L"PTE",
+                                &entry);
+        if (!NT_SUCCESS(status)) {
+            goto Exit;
+        }
+
+        if (((PHARDWARE_PTE)&entry)->Valid == 0) {
+            status = STATUS_NOT_FOUND;
+            goto Exit;
+        }
+
+        *PhysicalAddress = (entry & ARM_VALID_PFN_MASK) + (VirtualAddress & (PAGE_SIZE - 1));
+    }
+
+    status = STATUS_SUCCESS;
+
+Exit:
+    if (status == STATUS_NOT_FOUND) {
+        wprintf(L"%016I64x is not mapped\n", VirtualAddress);
+    }
+
+    return status;
+}
+
+
+static
+NTSTATUS
+ReadQueryMemory(
+    _In_ PQUERY_SESSION Session,
+    _In_ UINT64 Address,
+    _In_ UINT64 Length,
+    _In_ BOOL Virtual
+    )
+/*++
+
+Routine Description:
+
+    Reads and prints Length bytes at a physical or virtual address. Virtual
+    reads are translated a page at a time and stop at the first page that
+    is not mapped, what was read up to there is printed.
+
+--*/
+{
+    PUCHAR          buffer = nullptr;
+    LARGE_INTEGER   physicalAddress;
+    UINT64          translated;
+    UINT64          pageSize;
+    UINT64          done = 0;
+    UINT64          chunk;
+    NTSTATUS        status = STATUS_SUCCESS;
+
+    if ((Length == 0) || (Length > QUERY_MAX_LENGTH)) {
+        wprintf(L"Length must be between 1 and 0x%x\n", QUERY_MAX_LENGTH);
+        status = STATUS_INVALID_PARAMETER;
+        goto Exit;
+    }
+
+    buffer = (PUCHAR)malloc((size_t)Length);
+    if (buffer == nullptr) {
+        status = STATUS_NO_MEMORY;
+        goto Exit;
+    }
+
+    if (!Virtual) {
+        physicalAddress.QuadPart = (LONGLONG)Address;
+        status = ReadFromDDRSectionByPhysicalAddress(Session->Context, physicalAddress, Length, buffer);
+        if (!NT_SUCCESS(status)) {
+            wprintf(L"%016I64x - %016I64x is not in the DDR ranges\n", Address, Address + Length - 1);
+            goto Exit;
+        }
+
+        done = Length;
+        goto Exit;
+    }
+
+    while (done < Length) {
+        status = TranslateQueryAddress(Session, Address + done, FALSE, &translated, &pageSize);
+        if (!NT_SUCCESS(status)) {
+            goto Exit;
+        }
+
+        chunk = min(Length - done, pageSize - ((Address + done) & (pageSize - 1)));
+        physicalAddress.QuadPart = (LONGLONG)translated;
+        status = ReadFromDDRSectionByPhysicalAddress(Session->Context, physicalAddress, chunk, buffer + done);
+        if (!NT_SUCCESS(status)) {
+            wprintf(L"%016I64x maps to %016I64x which is not in the DDR ranges\n", Address + done, translated);
+            goto Exit;
+        }
+
+        done += chunk;
+    }
+
+Exit:
+    if (done != 0) {
+        PrintQueryBytes(Address, buffer, (SIZE_T)done);
+    }
+
+    if (buffer != nullptr) {
+        free(buffer);
+    }
+
+    return status;
+}
+
+
+static
+NTSTATUS
+ScanQueryDumpHeader(
+    _Inout_ PQUERY_SESSION Session
+    )
+/*++
+
+Routine Description:
+
+    Searches the raw dump for the DUMP_HEADER the way a conversion does and
+    takes the bitness and the directory table base from it. AP_REG is not
+    searched for.
+
+--*/
+{
+    PDMP_CONTEXT    context = Session->Context;
+    NTSTATUS        status = STATUS_UNSUCCESSFUL;
+
+    context->IsAPREGRequested = FALSE;
+    context->isAPREG64 = FALSE;
+    context->DumpHeaderAddress.QuadPart = 0;
+
+    if (FAILED(SearchDumpHeaderAndAPREG(context)) || (context->DumpHeaderAddress.QuadPart == 0)) {
+        wprintf(L"No DUMP_HEADER found in the raw dump\n");
+        goto Exit;
+    }
+
+    if (context->Is64Bit) {
+        if (context->DumpHeader64 != nullptr) {
+            free(context->DumpHeader64);
+            context->DumpHeader64 = nullptr;
+        }
+
+        status = GetDumpHeader64(context);
+        if (!NT_SUCCESS(status)) {
+            goto Exit;
+        }
+
+        Session->DirectoryTableBase = (UINT64)context->DumpHeader64->DirectoryTableBase;
+        Session->PaeEnabled = FALSE;
+    }
+    else {
+        if (context->DumpHeader != nullptr) {
+            free(context->DumpHeader);
+            context->DumpHeader = nullptr;
+        }
+
+        if (FAILED(GetDumpHeader32(context))) {
+            status = STATUS_BAD_DATA;
+            goto Exit;
+        }
+
+        Session->DirectoryTableBase = (UINT64)context->DumpHeader->DirectoryTableBase;
+        Session->PaeEnabled = (context->DumpHeader->PaeEnabled != FALSE);
+    }
+
+    Session->Is64Bit = context->Is64Bit;
+    wprintf(L"DUMP_HEADER at offset %I64x, %u-bit, directory table base %I64x%s\n",
+            context->DumpHeaderAddress.QuadPart,
+            Session->Is64Bit ? 64 : 32,
+            Session->DirectoryTableBase,
+            Session->PaeEnabled ? L" (PAE)" : L"");
+    status = STATUS_SUCCESS;
+
+Exit:
+    return status;
+}
+
+
+static
+VOID
+PrintQueryMap(
+    _In_ PQUERY_SESSION Session
+    )
+{
+    PDMP_CONTEXT    context = Session->Context;
+    UINT32          index;
+
+    wprintf(L"%u DDR ranges from the %s\n",
+            context->DDRMemoryMapCount,
+            Session->IndexLoaded ? L"raw dump index" : L"section table");
+    for (index = 0; index < context->DDRMemoryMapCount; index++) {
+        wprintf(L"  %016I64x - %016I64x  at offset %016I64x%s\n",
+                context->DDRMemoryMap[index].Base,
+                context->DDRMemoryMap[index].End,
+                context->DDRMemoryMap[index].Offset,
+                context->DDRMemoryMap[index].Contiguous ? L"" : L"  (after a hole)");
+    }
+
+    if (Session->IndexLoaded) {
+        wprintf(L"DUMP_HEADER PA %I64x, KdDebuggerDataBlock PA %I64x, AP_REG PA %I64x\n",
+                Session->Index.DumpHeaderPA,
+                Session->Index.KdDebuggerDataBlockPA,
+                Session->Index.APRegPA);
+    }
+
+    wprintf(L"%u-bit, directory table base %I64x%s\n",
+            Session->Is64Bit ? 64 : 32,
+            Session->DirectoryTableBase,
+            Session->PaeEnabled ? L" (PAE)" : L"");
+}
+
+
+static
+VOID
+PrintQueryHelp()
+{
+    wprintf(
+            L"  pa <address> [length]   Dump physical memory\n"
+            L"  va <address> [length]   Dump virtual memory\n"
+            L"  walk <address>          Show the page table entries of a virtual address\n"
+            L"  dtb [address]           Show or set the directory table base\n"
+            L"  bits [32 | 64]          Show or set the page table format\n"
+            L"  scan                    Search the raw dump for the DUMP_HEADER to get the directory table base\n"
+            L"  map                     Show the DDR ranges\n"
+            L"  quit\n"
+            L"  Numbers are hex, the default length is 0x%x.\n",
+            QUERY_DEFAULT_LENGTH);
+}
+
+
+static
+NTSTATUS
+RunQueryCommand(
+    _Inout_ PQUERY_SESSION Session,
+    _In_ UINT32 TokenCount,
+    _In_reads_(TokenCount) WCHAR const * const * Tokens
+    )
+{
+    UINT64      address = 0;
+    UINT64      length = QUERY_DEFAULT_LENGTH;
+    UINT64      translated;
+    UINT64      pageSize;
+    LPCWSTR     command = Tokens[0];
+    NTSTATUS    status = STATUS_SUCCESS;
+
+    if ((_wcsicmp(command, L"pa") == 0) || (_wcsicmp(command, L"va") == 0)) {
+        if ((TokenCount < 2) || (TokenCount > 3) ||
+            !ParseQueryNumber(Tokens[1], &address) ||
+            ((TokenCount == 3) && !ParseQueryNumber(Tokens[2], &length))) {
+            goto Usage;
+        }
+
+        status = ReadQueryMemory(Session, address, length, (_wcsicmp(command, L"va") == 0));
+    }
+    else if (_wcsicmp(command, L"walk") == 0) {
+        if ((TokenCount != 2) || !ParseQueryNumber(Tokens[1], &address)) {
+            goto Usage;
+        }
+
+        wprintf(L"%016I64x\n", address);
+        status = TranslateQueryAddress(Session, address, TRUE, &translated, &pageSize);
+        if (NT_SUCCESS(status)) {
+            wprintf(L"  maps to %016I64x in a 0x%I64x byte page\n", translated, pageSize);
+        }
+    }
+    else if (_wcsicmp(command, L"dtb") == 0) {
+        if (TokenCount == 2) {
+            if (!ParseQueryNumber(Tokens[1], &address)) {
+                goto Usage;
+            }
+
+            Session->DirectoryTableBase = address;
+        }
+
+        wprintf(L"Directory table base %I64x\n", Session->DirectoryTableBase);
+    }
+    else if (_wcsicmp(command, L"bits") == 0) {
+        if (TokenCount == 2) {
+            if (wcscmp(Tokens[1], L"64") == 0) {
+                Session->Is64Bit = TRUE;
+            }
+            else if (wcscmp(Tokens[1], L"32") == 0) {
+                Session->Is64Bit = FALSE;
+            }
+            else {
+                goto Usage;
+            }
+        }
+
+        wprintf(L"%u-bit page tables\n", Session->Is64Bit ? 64 : 32);
+    }
+    else if (_wcsicmp(command, L"scan") == 0) {
+        status = ScanQueryDumpHeader(Session);
+    }
+    else if (_wcsicmp(command, L"map") == 0) {
+        PrintQueryMap(Session);
+    }
+    else if ((_wcsicmp(command, L"help") == 0) || (_wcsicmp(command, L"?") == 0)) {
+        PrintQueryHelp();
+    }
+    else {
+        goto Usage;
+    }
+
+    goto Exit;
+
+Usage:
+    wprintf(L"Unexpected query '%s'\n", command);
+    PrintQueryHelp();
+    status = STATUS_INVALID_PARAMETER;
+
+Exit:
+    return status;
+}
+
+
+HRESULT
+RunQuery(
+    _Inout_ PDMP_CONTEXT Context,
+    _In_ LPCWSTR FileName,
+    _In_ UINT32 ArgCount,
+    _In_reads_(ArgCount) WCHAR const * const * Args
+    )
+/*++
+
+Routine Description:
+
+    Opens a raw dump for random access and runs queries against it. The
+    queries are taken from Args, separated by ';', or else read from the
+    standard input one per line until it ends or quit is entered.
+
+Arguments:
+
+    Context - Pointer to DmpContext
+
+    FileName - Raw dump file
+
+    ArgCount - Number of query arguments
+
+    Args - Query arguments from the command line
+
+Return Value:
+
+    HRESULT. E_FAIL if any query failed.
+
+--*/
+{
+    QUERY_SESSION   session = { 0 };
+    WCHAR           line[QUERY_MAX_LINE];
+    WCHAR const*    tokens[QUERY_MAX_TOKENS];
+    WCHAR*          next = nullptr;
+    WCHAR*          token;
+    UINT32          tokenCount;
+    UINT32          index;
+    BOOL            valid = FALSE;
+    BOOL            interactive;
+    DWORD           mode;
+    HRESULT         hr = S_OK;
+
+    session.Context = Context;
+
+    if (FAILED(hr = Context->hDisk.Open(FileName))) {
+        LogLibErrorPrintf(
+                hr,
+                __LINE__,
+                WIDEN(__FUNCTION__),
+                __WFILE__,
+                L"Error: Failed to open raw dump %s\n",
+                FileName);
+        goto Exit;
+    }
+
+    if (FAILED(hr = VerifyRawDumpHeader(Context, &valid)) || !valid ||
+        FAILED(hr = VerifyRawDumpSectionTable(Context, &valid)) || !valid) {
+        hr = FAILED(hr) ? hr : E_FAIL;
+        LogLibErrorPrintf(
+                hr,
+                __LINE__,
+                WIDEN(__FUNCTION__),
+                __WFILE__,
+                L"Error: %s is not a valid raw dump\n",
+                FileName);
+        goto Exit;
+    }
+
+    //
+    // 64-bit page tables are walked the ARM64 way, x64 ones are not walked.
+    //
+    session.Is64Bit = (Context->SectionStats.CpuArchitecture == PROCESSOR_ARCHITECTURE_ARM64);
+    session.Amd64 = (Context->SectionStats.CpuArchitecture == PROCESSOR_ARCHITECTURE_AMD64);
+
+    if (!LoadQueryIndex(&session) && !NT_SUCCESS(BuildDDRMemoryMap(Context))) {
+        hr = E_FAIL;
+        LogLibErrorPrintf(
+                hr,
+                __LINE__,
+                WIDEN(__FUNCTION__),
+                __WFILE__,
+                L"Error: Failed to build the DDR memory map\n");
+        goto Exit;
+    }
+
+    PrintQueryMap(&session);
+
+    if (ArgCount != 0) {
+        for (index = 0; index < ArgCount; index += tokenCount + 1) {
+            tokenCount = 0;
+            while ((index + tokenCount < ArgCount) && (wcscmp(Args[index + tokenCount], L";") != 0)) {
+                tokenCount++;
+            }
+
+            if (tokenCount == 0) {
+                continue;
+            }
+
+            if (!NT_SUCCESS(RunQueryCommand(&session, tokenCount, &Args[index]))) {
+                hr = E_FAIL;
+            }
+        }
+
+        goto Exit;
+    }
+
+    interactive = GetConsoleMode(GetStdHandle(STD_INPUT_HANDLE), &mode);
+    for (;;) {
+        if (interactive) {
+            wprintf(L"query> ");
+        }
+
+        if (fgetws(line, ARRAYSIZE(line), stdin) == nullptr) {
+            break;
+        }
+
+        tokenCount = 0;
+        for (token = wcstok_s(line, L" \t\r\n", &next);
+             (token != nullptr) && (tokenCount < ARRAYSIZE(tokens));
+             token = wcstok_s(nullptr, L" \t\r\n", &next)) {
+            tokens[tokenCount++] = token;
+        }
+
+        if (tokenCount == 0) {
+            continue;
+        }
+
+        if ((_wcsicmp(tokens[0], L"quit") == 0) || (_wcsicmp(tokens[0], L"exit") == 0)) {
+            break;
+        }
+
+        if (!NT_SUCCESS(RunQueryCommand(&session, tokenCount, tokens)) && !interactive) {
+            hr = E_FAIL;
+        }
+    }
+
+Exit:
+    return hr;
+}
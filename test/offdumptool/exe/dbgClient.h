@@ -1,32 +1,43 @@
-/*++
-
-    Copyright (C) Microsoft. All rights reserved.
-
-Module Name:
-   dbgclient.h
-
-Environment:
-   User Mode
-
-Author:
-   radutta 
---*/
-#pragma once
-#include <dbgeng.h>
-
-class DbgClient
-{
-    DbgClient();
-    DbgClient(const DbgClient &);
-
-public:
-
-    static BOOL Initialize(__in PCWSTR pszDmp, __in_opt PCWSTR pszSymPath);
-    static IDebugSymbols3 *GetSymbols();
-    static IDebugDataSpaces2 *GetDataSpaces();
-
-private:
-
-    static IDebugSymbols3 *s_pSymbols;
-    static IDebugDataSpaces2 *s_pSpaces;
-};
+/*++
+
+    Copyright (C) Microsoft. All rights reserved.
+
+Module Name:
+   dbgclient.h
+
+Environment:
+   User Mode
+
+Author:
+   radutta 
+--*/
+#pragma once
+#include <dbgeng.h>
+
+class DbgClient
+{
+    DbgClient();
+    DbgClient(const DbgClient &);
+
+public:
+
+    static BOOL Initialize(__in PCWSTR pszDmp, __in_opt PCWSTR pszSymPath);
+    static VOID Uninitialize();
+    static IDebugSymbols3 *GetSymbols();
+    static IDebugDataSpaces2 *GetDataSpaces();
+
+    //
+    // dbgeng holds a single session per process. Callers that may run
+    // concurrently hold the lock from Initialize until Uninitialize.
+    //
+    static VOID Lock();
+    static VOID Unlock();
+
+private:
+
+    static HMODULE s_hDbgEng;
+    static IDebugClient4 *s_pClient;
+    static IDebugSymbols3 *s_pSymbols;
+    static IDebugDataSpaces2 *s_pSpaces;
+    static SRWLOCK s_Lock;
+};
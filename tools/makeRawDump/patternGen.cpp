@@ -0,0 +1,582 @@
+/*++
+
+Copyright (C) Microsoft. All rights reserved.
+
+Module Name:
+    patternGen.cpp
+
+Environment:
+    User Mode
+
+--*/
+
+#include <stdio.h>
+#include <string.h>
+
+#if defined(_M_IX86) || defined(_M_X64)
+#include <emmintrin.h>
+#define PATTERN_FILL_SSE2
+#elif defined(_M_ARM64)
+#include <arm64_neon.h>
+#define PATTERN_FILL_NEON
+#endif
+
+#include "patternGen.h"
+
+// Pattern values for two periods, so that a whole stride can be copied from any phase
+#define PATTERN_TILE_SIZE                   (2 * TEST_PATTERN_SIZE)
+
+C_ASSERT((TEST_PATTERN_SIZE + PATTERN_FILL_STRIDE) <= PATTERN_TILE_SIZE);
+C_ASSERT(0 == (PATTERN_BUFFER_SIZE % PATTERN_SLICE_SIZE));
+C_ASSERT(0 == (PATTERN_SLICE_SIZE % PATTERN_FILL_STRIDE));
+
+
+/****************************************************************************************************
+** void ReportProgress(
+**          _Inout_ PWRITE_PROGRESS progress,
+**          _In_ ULONGLONG bytesWritten,
+**          _In_ BOOL done)
+**
+** Description:
+**  Prints the spinner and the number of megabytes written, at most once every
+**  PROGRESS_INTERVAL_MS, and the final count with the throughput when done.
+**
+** Arguments:
+**  progress - progress state, startTick must be set before the first call
+**  bytesWritten - number of bytes written so far
+**  done - TRUE for the final line
+**
+*****************************************************************************************************/
+static void ReportProgress(_Inout_ PWRITE_PROGRESS progress, _In_ ULONGLONG bytesWritten, _In_ BOOL done)
+{
+    static const char   spinner[] = { '\\', '|', '/', '-' };
+    ULONGLONG           now = GetTickCount64();
+
+    if (done)
+    {
+        ULONGLONG elapsed = (now > progress->startTick) ? (now - progress->startTick) : 1;
+
+        printf("\r *  %lld Mbytes written successfully, %lld Mbytes/s\r\n",
+               bytesWritten / ONE_MEGABYTE,
+               (bytesWritten / ONE_MEGABYTE) * 1000 / elapsed);
+    }
+    else if ((now - progress->lastTick) >= PROGRESS_INTERVAL_MS)
+    {
+        progress->lastTick = now;
+        printf("\r %c  %lld Mbytes written             ", spinner[progress->spin++ % ArrayCount(spinner)], bytesWritten / ONE_MEGABYTE);
+    }
+
+}
+
+
+/****************************************************************************************************
+** void FillPattern(
+**          _Out_writes_bytes_(size) PCHAR buffer,
+**          _In_ size_t size,
+**          _In_ ULONGLONG fileOffset)
+**
+** Description:
+**  Fills the buffer with the test pattern as it appears at fileOffset in the output, each byte
+**  is OFFSET2VALUE() of its own offset.  The pattern repeats every TEST_PATTERN_SIZE bytes, so
+**  the buffer is filled a stride at a time from a tile holding two periods, starting at the
+**  phase of the current offset.  Full strides use non-temporal vector stores, the buffers are
+**  far larger than the cache and are not read back before they are written out.
+**
+** Arguments:
+**  buffer - buffer to fill
+**  size - number of bytes to fill
+**  fileOffset - offset in the output of the first byte of the buffer
+**
+*****************************************************************************************************/
+void FillPattern(_Out_writes_bytes_(size) PCHAR buffer, _In_ size_t size, _In_ ULONGLONG fileOffset)
+{
+    UCHAR       tile[PATTERN_TILE_SIZE];
+    size_t      phase = (size_t)(fileOffset % TEST_PATTERN_SIZE);
+    size_t      i = 0;
+
+    for (size_t t = 0; t < sizeof tile; t++)
+    {
+        tile[t] = (UCHAR)OFFSET2VALUE(t);
+    }
+
+    // Bytes up to the first 16 byte boundary
+    while ((i < size) && (0 != ((ULONG_PTR)(buffer + i) & 0xF)))
+    {
+        buffer[i++] = (CHAR)tile[phase];
+        phase = (phase + 1) % TEST_PATTERN_SIZE;
+    }
+
+#if defined(PATTERN_FILL_SSE2)
+    for (; (size - i) >= PATTERN_FILL_STRIDE; i += PATTERN_FILL_STRIDE)
+    {
+        _mm_stream_si128((__m128i*)(buffer + i),      _mm_loadu_si128((const __m128i*)&tile[phase]));
+        _mm_stream_si128((__m128i*)(buffer + i + 16), _mm_loadu_si128((const __m128i*)&tile[phase + 16]));
+        _mm_stream_si128((__m128i*)(buffer + i + 32), _mm_loadu_si128((const __m128i*)&tile[phase + 32]));
+        _mm_stream_si128((__m128i*)(buffer + i + 48), _mm_loadu_si128((const __m128i*)&tile[phase + 48]));
+        phase = (phase + PATTERN_FILL_STRIDE) % TEST_PATTERN_SIZE;
+    }
+
+    _mm_sfence();
+
+#elif defined(PATTERN_FILL_NEON)
+    for (; (size - i) >= PATTERN_FILL_STRIDE; i += PATTERN_FILL_STRIDE)
+    {
+        vst1q_u8((uint8_t*)(buffer + i),      vld1q_u8(&tile[phase]));
+        vst1q_u8((uint8_t*)(buffer + i + 16), vld1q_u8(&tile[phase + 16]));
+        vst1q_u8((uint8_t*)(buffer + i + 32), vld1q_u8(&tile[phase + 32]));
+        vst1q_u8((uint8_t*)(buffer + i + 48), vld1q_u8(&tile[phase + 48]));
+        phase = (phase + PATTERN_FILL_STRIDE) % TEST_PATTERN_SIZE;
+    }
+
+#else
+    for (; (size - i) >= PATTERN_FILL_STRIDE; i += PATTERN_FILL_STRIDE)
+    {
+        memcpy(buffer + i, &tile[phase], PATTERN_FILL_STRIDE);
+        phase = (phase + PATTERN_FILL_STRIDE) % TEST_PATTERN_SIZE;
+    }
+
+#endif
+
+    // Remaining bytes, less than a stride
+    for (; i < size; i++)
+    {
+        buffer[i] = (CHAR)tile[phase];
+        phase = (phase + 1) % TEST_PATTERN_SIZE;
+    }
+
+}
+
+
+/****************************************************************************************************
+** DWORD WINAPI FillWorker(_In_ LPVOID parameter)
+**
+** Description:
+**  Pool thread, fills one slice of the current buffer each time the work semaphore is released
+**  and signals the done event when the last slice of the buffer is filled.
+**
+*****************************************************************************************************/
+static DWORD WINAPI FillWorker(_In_ LPVOID parameter)
+{
+    PPATTERN_FILL_POOL  pool = (PPATTERN_FILL_POOL)parameter;
+
+    while (WAIT_OBJECT_0 == WaitForSingleObject(pool->workSemaphore, INFINITE))
+    {
+        if (pool->shutdown)
+        {
+            break;
+        }
+
+        size_t begin = (size_t)(InterlockedIncrement(&pool->nextSlice) - 1) * PATTERN_SLICE_SIZE;
+        size_t size = ((pool->bufferSize - begin) < PATTERN_SLICE_SIZE) ? (pool->bufferSize - begin) : PATTERN_SLICE_SIZE;
+
+        FillPattern(pool->buffer + begin, size, pool->fileOffset + begin);
+        if (0 == InterlockedDecrement(&pool->slicesLeft))
+        {
+            SetEvent(pool->doneEvent);
+        }
+
+    }
+
+    return 0;
+}
+
+
+/****************************************************************************************************
+** HRESULT OpenFillPool(_Out_ PPATTERN_FILL_POOL pool)
+**
+** Description:
+**  Starts one fill thread per processor, keeping one processor for the writes, and no more than
+**  there are slices in a buffer.  With no threads the buffers are filled by the caller.
+**
+*****************************************************************************************************/
+static HRESULT OpenFillPool(_Out_ PPATTERN_FILL_POOL pool)
+{
+    HRESULT     hr = S_OK;
+    SYSTEM_INFO sysInfo;
+
+    ZeroMemory(pool, sizeof(*pool));
+    GetSystemInfo(&sysInfo);
+
+    if ( (nullptr == (pool->workSemaphore = CreateSemaphore(NULL, 0, PATTERN_MAX_FILL_THREADS, NULL))) ||
+         (nullptr == (pool->doneEvent = CreateEvent(NULL, FALSE, FALSE, NULL)))
+       )
+    {
+        hr = HRESULT_FROM_WIN32(GetLastError());
+        printf("ERROR: failed to create the pattern fill pool, (%#lx)\r\n", hr);
+    }
+    else
+    {
+        UINT32 threadCount = (sysInfo.dwNumberOfProcessors > 1) ? (sysInfo.dwNumberOfProcessors - 1) : 0;
+
+        if (threadCount > PATTERN_MAX_FILL_THREADS)
+        {
+            threadCount = PATTERN_MAX_FILL_THREADS;
+        }
+
+        for (pool->threadCount = 0; pool->threadCount < threadCount; pool->threadCount++)
+        { // A thread that cannot be created only means fewer fill threads
+            if (nullptr == (pool->threads[pool->threadCount] = CreateThread(NULL, 0, FillWorker, pool, 0, NULL)))
+            {
+                break;
+            }
+
+        }
+
+    }
+
+    return hr;
+}
+
+
+/****************************************************************************************************
+** void CloseFillPool(_Inout_ PPATTERN_FILL_POOL pool)
+*****************************************************************************************************/
+static void CloseFillPool(_Inout_ PPATTERN_FILL_POOL pool)
+{
+    if (0 != pool->threadCount)
+    {
+        pool->shutdown = TRUE;
+        ReleaseSemaphore(pool->workSemaphore, pool->threadCount, NULL);
+        WaitForMultipleObjects(pool->threadCount, pool->threads, TRUE, INFINITE);
+        for (UINT32 i = 0; i < pool->threadCount; i++)
+        {
+            CloseHandle(pool->threads[i]);
+        }
+
+    }
+
+    if (nullptr != pool->doneEvent)
+    {
+        CloseHandle(pool->doneEvent);
+    }
+
+    if (nullptr != pool->workSemaphore)
+    {
+        CloseHandle(pool->workSemaphore);
+    }
+
+    ZeroMemory(pool, sizeof(*pool));
+}
+
+
+/****************************************************************************************************
+** void StartFill(
+**          _Inout_ PPATTERN_FILL_POOL pool,
+**          _Out_writes_bytes_(size) PCHAR buffer,
+**          _In_ size_t size,
+**          _In_ ULONGLONG fileOffset)
+**
+** Description:
+**  Hands the slices of a buffer to the pool, the caller waits for the done event before using
+**  the buffer or starting another fill.
+**
+*****************************************************************************************************/
+static void StartFill(_Inout_ PPATTERN_FILL_POOL pool, _Out_writes_bytes_(size) PCHAR buffer, _In_ size_t size, _In_ ULONGLONG fileOffset)
+{
+    LONG slices = (LONG)((size + PATTERN_SLICE_SIZE - 1) / PATTERN_SLICE_SIZE);
+
+    pool->buffer = buffer;
+    pool->bufferSize = size;
+    pool->fileOffset = fileOffset;
+    pool->nextSlice = 0;
+    pool->slicesLeft = slices;
+
+    if (0 == pool->threadCount)
+    {
+        FillPattern(buffer, size, fileOffset);
+        SetEvent(pool->doneEvent);
+    }
+    else
+    {
+        ReleaseSemaphore(pool->workSemaphore, slices, NULL);
+    }
+
+}
+
+
+/****************************************************************************************************
+** HRESULT WritePatternAt(
+**          _Inout_ DEVICE_IO *oFile,
+**          _In_ ULONGLONG fileOffset,
+**          _In_ ULARGE_INTEGER writeSize,
+**          _Out_ ULARGE_INTEGER *bytesWritten)
+**
+** Description:
+**  Writes writeSize bytes of the test pattern at the current position of oFile, which is
+**  fileOffset.  Two PATTERN_BUFFER_SIZE buffers are used in turn, the pool fills the next one
+**  while the current one is written.
+**
+** Arguments:
+**  oFile - output file handle (DEVICE_IO)
+**  fileOffset - offset in the output of the first byte written, sets the pattern phase
+**  writeSize - total size to write
+**  bytesWritten - number of bytes written, returned to caller
+**
+** Return:
+**  HRESULT
+**
+*****************************************************************************************************/
+HRESULT WritePatternAt(_Inout_ DEVICE_IO *oFile, _In_ ULONGLONG fileOffset, _In_ ULARGE_INTEGER writeSize, _Out_ ULARGE_INTEGER *bytesWritten)
+{
+    HRESULT             hr = S_OK;
+    PATTERN_FILL_POOL   pool = { 0 };
+    PCHAR               buffers[PATTERN_BUFFER_COUNT] = { 0 };
+
+    if ((nullptr == oFile) || (nullptr == bytesWritten))
+    { // Bad pointers
+        printf("ERROR: invalid pointers passed to WritePatternAt()\r\n");
+        hr = E_INVALIDARG;
+    }
+    else if (0 == writeSize.QuadPart)
+    { // Invalid arguments
+        printf("ERROR: invalid size values passed to WritePatternAt()\r\n");
+        hr = E_INVALIDARG;
+    }
+    else if (FAILED(hr = OpenFillPool(&pool)))
+    { // OpenFillPool() reported the failure
+    }
+    else if ( (nullptr == (buffers[0] = (PCHAR)VirtualAlloc(NULL, PATTERN_BUFFER_SIZE, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE))) ||
+              (nullptr == (buffers[1] = (PCHAR)VirtualAlloc(NULL, PATTERN_BUFFER_SIZE, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE)))
+            )
+    {
+        printf("ERROR: failed to allocate %d bytes for the pattern buffers\r\n", PATTERN_BUFFER_COUNT * PATTERN_BUFFER_SIZE);
+        hr = E_OUTOFMEMORY;
+    }
+    else
+    {
+        WRITE_PROGRESS  progress = { 0 };
+        ULONGLONG       bytesLeft = writeSize.QuadPart;
+        size_t          sizes[PATTERN_BUFFER_COUNT] = { 0 };
+        UINT32          current = 0;
+        BOOL            filling = TRUE;
+
+        (*bytesWritten).QuadPart = 0;
+        progress.startTick = GetTickCount64();
+
+        sizes[current] = (size_t)((bytesLeft < PATTERN_BUFFER_SIZE) ? bytesLeft : PATTERN_BUFFER_SIZE);
+        StartFill(&pool, buffers[current], sizes[current], fileOffset);
+
+        while (SUCCEEDED(hr) && (bytesLeft > 0))
+        {
+            UINT32      next = (current + 1) % PATTERN_BUFFER_COUNT;
+            ULONGLONG   nextLeft = bytesLeft - sizes[current];
+            size_t      bWrite = 0;
+
+            WaitForSingleObject(pool.doneEvent, INFINITE);
+            filling = FALSE;
+
+            if (nextLeft > 0)
+            { // Fill the next buffer during the write of this one
+                sizes[next] = (size_t)((nextLeft < PATTERN_BUFFER_SIZE) ? nextLeft : PATTERN_BUFFER_SIZE);
+                StartFill(&pool, buffers[next], sizes[next], fileOffset + (writeSize.QuadPart - nextLeft));
+                filling = TRUE;
+            }
+
+            if (FAILED(hr = oFile->Write(buffers[current], sizes[current], &bWrite)))
+            {
+                printf("\r\nERROR: failed to write at offset %lld, (%#x)\r\n", fileOffset + (*bytesWritten).QuadPart, hr);
+            }
+            else if (bWrite != sizes[current])
+            {
+                printf("\r\nERROR: partial write at offset %lld\r\n", fileOffset + (*bytesWritten).QuadPart);
+                hr = E_FAIL;
+            }
+            else
+            {
+                (*bytesWritten).QuadPart += bWrite;
+                bytesLeft = nextLeft;
+                current = next;
+                ReportProgress(&progress, (*bytesWritten).QuadPart, FALSE);
+            }
+
+        }
+
+        if (filling)
+        { // The pool may not be closed or the buffers freed under a running fill
+            WaitForSingleObject(pool.doneEvent, INFINITE);
+        }
+
+        if (SUCCEEDED(hr))
+        {
+            ReportProgress(&progress, (*bytesWritten).QuadPart, TRUE);
+        }
+
+    }
+
+    for (UINT32 i = 0; i < PATTERN_BUFFER_COUNT; i++)
+    {
+        if (nullptr != buffers[i])
+        {
+            VirtualFree(buffers[i], 0, MEM_RELEASE);
+        }
+
+    }
+
+    CloseFillPool(&pool);
+
+    return hr;
+}
+
+
+/****************************************************************************************************
+** HRESULT WriteZeros(
+**          _Inout_ DEVICE_IO *oFile,
+**          _In_ ULARGE_INTEGER writeSize,
+**          _Out_ ULARGE_INTEGER *bytesWritten)
+**
+** Description:
+**  Writes writeSize bytes of zeros at the current position of oFile, PATTERN_BUFFER_SIZE bytes
+**  at a time.  Used for partitions, where the padding must really be written.
+**
+** Arguments:
+**  oFile - output file handle (DEVICE_IO)
+**  writeSize - total size to write
+**  bytesWritten - number of bytes written, returned to caller
+**
+** Return:
+**  HRESULT
+**
+*****************************************************************************************************/
+HRESULT WriteZeros(_Inout_ DEVICE_IO *oFile, _In_ ULARGE_INTEGER writeSize, _Out_ ULARGE_INTEGER *bytesWritten)
+{
+    HRESULT     hr = S_OK;
+    PCHAR       buffer = nullptr;
+
+    if ((nullptr == oFile) || (nullptr == bytesWritten))
+    { // Bad pointers
+        printf("ERROR: invalid pointers passed to WriteZeros()\r\n");
+        hr = E_INVALIDARG;
+    }
+    else if (nullptr == (buffer = (PCHAR)VirtualAlloc(NULL, PATTERN_BUFFER_SIZE, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE)))
+    { // VirtualAlloc() returns zeroed pages
+        printf("ERROR: failed to allocate %d bytes for the padding buffer\r\n", PATTERN_BUFFER_SIZE);
+        hr = E_OUTOFMEMORY;
+    }
+    else
+    {
+        WRITE_PROGRESS  progress = { 0 };
+        ULONGLONG       bytesLeft = writeSize.QuadPart;
+
+        (*bytesWritten).QuadPart = 0;
+        progress.startTick = GetTickCount64();
+
+        while (SUCCEEDED(hr) && (bytesLeft > 0))
+        {
+            size_t  size = (size_t)((bytesLeft < PATTERN_BUFFER_SIZE) ? bytesLeft : PATTERN_BUFFER_SIZE);
+            size_t  bWrite = 0;
+
+            if (FAILED(hr = oFile->Write(buffer, size, &bWrite)))
+            {
+                printf("\r\nERROR: failed to write padding at %lld bytes, (%#x)\r\n", (*bytesWritten).QuadPart, hr);
+            }
+            else if (bWrite != size)
+            {
+                printf("\r\nERROR: partial padding write at %lld bytes\r\n", (*bytesWritten).QuadPart);
+                hr = E_FAIL;
+            }
+            else
+            {
+                (*bytesWritten).QuadPart += bWrite;
+                bytesLeft -= bWrite;
+                ReportProgress(&progress, (*bytesWritten).QuadPart, FALSE);
+            }
+
+        }
+
+        if (SUCCEEDED(hr))
+        {
+            ReportProgress(&progress, (*bytesWritten).QuadPart, TRUE);
+        }
+
+        VirtualFree(buffer, 0, MEM_RELEASE);
+    }
+
+    return hr;
+}
+
+
+/****************************************************************************************************
+** HRESULT WriteSparse(
+**          _Inout_ DEVICE_IO *oFile,
+**          _In_ ULONGLONG beginOffset,
+**          _In_ ULONGLONG endOffset)
+**
+** Description:
+**  Makes the output file sparse and extends it to endOffset, leaving [beginOffset, endOffset)
+**  as a hole that reads back as zeros without being written.  The file is opened a second time
+**  by name, DEVICE_IO shares it for writing.  Data left from an earlier, larger file in the
+**  range is released as well.  Only plain files can be sparse.
+**
+** Arguments:
+**  oFile - output file handle (DEVICE_IO)
+**  beginOffset - first byte of the hole
+**  endOffset - size of the file
+**
+** Return:
+**  HRESULT
+**
+*****************************************************************************************************/
+HRESULT WriteSparse(_Inout_ DEVICE_IO *oFile, _In_ ULONGLONG beginOffset, _In_ ULONGLONG endOffset)
+{
+    HRESULT     hr = S_OK;
+    HANDLE      hFile = INVALID_HANDLE_VALUE;
+
+    if (nullptr == oFile)
+    {
+        printf("ERROR: invalid pointers passed to WriteSparse()\r\n");
+        hr = E_INVALIDARG;
+    }
+    else if (DEVICE_IO::PLAIN_FILE_DEVICE_TYPE != oFile->GetDeviceType())
+    {
+        printf("ERROR: sparse output is only supported for files\r\n");
+        hr = HRESULT_FROM_WIN32(ERROR_NOT_SUPPORTED);
+    }
+    else if (beginOffset >= endOffset)
+    { // Nothing to leave out
+    }
+    else if (INVALID_HANDLE_VALUE == (hFile = CreateFileW(oFile->GetDeviceName().c_str(),
+                                                          FILE_GENERIC_READ | FILE_GENERIC_WRITE,
+                                                          FILE_SHARE_READ | FILE_SHARE_WRITE,
+                                                          NULL,
+                                                          OPEN_EXISTING,
+                                                          0,
+                                                          NULL)))
+    {
+        hr = HRESULT_FROM_WIN32(GetLastError());
+        printf("ERROR: failed to open \"%ls\" to make it sparse, (%#lx)\r\n", oFile->GetDeviceName().c_str(), hr);
+    }
+    else
+    {
+        FILE_ZERO_DATA_INFORMATION  zeroData;
+        LARGE_INTEGER               fileSize;
+        DWORD                       bytesReturned = 0;
+
+        fileSize.QuadPart = (LONGLONG)endOffset;
+        zeroData.FileOffset.QuadPart = (LONGLONG)beginOffset;
+        zeroData.BeyondFinalZero.QuadPart = (LONGLONG)endOffset;
+
+        if (!DeviceIoControl(hFile, FSCTL_SET_SPARSE, NULL, 0, NULL, 0, &bytesReturned, NULL))
+        {
+            hr = HRESULT_FROM_WIN32(GetLastError());
+            printf("ERROR: the file system cannot make \"%ls\" sparse, (%#lx)\r\n", oFile->GetDeviceName().c_str(), hr);
+        }
+        else if (!SetFilePointerEx(hFile, fileSize, NULL, FILE_BEGIN) || !SetEndOfFile(hFile))
+        {
+            hr = HRESULT_FROM_WIN32(GetLastError());
+            printf("ERROR: failed to extend \"%ls\" to %lld bytes, (%#lx)\r\n", oFile->GetDeviceName().c_str(), endOffset, hr);
+        }
+        else if (!DeviceIoControl(hFile, FSCTL_SET_ZERO_DATA, &zeroData, sizeof(zeroData), NULL, 0, &bytesReturned, NULL))
+        {
+            hr = HRESULT_FROM_WIN32(GetLastError());
+            printf("ERROR: failed to release the payload range of \"%ls\", (%#lx)\r\n", oFile->GetDeviceName().c_str(), hr);
+        }
+        else
+        {
+            printf("INFO: %lld bytes of payload left sparse\r\n", endOffset - beginOffset);
+        }
+
+        CloseHandle(hFile);
+    }
+
+    return hr;
+}
@@ -0,0 +1,55 @@
+/*++
+
+Copyright (C) Microsoft. All rights reserved.
+
+Module Name:
+    patternGen.h
+
+Abstract:
+    Writes the payload test pattern and the padding of a raw dump in large
+    buffers. The pattern buffers are filled by a pool of threads with vector
+    stores while the previous buffer is being written, so that the output
+    device rather than the CPU or the console sets the pace.
+
+Environment:
+    User Mode
+
+--*/
+
+#pragma once
+
+#include "makeDumpFile.h"
+
+#define PATTERN_BUFFER_SIZE                 (8 * ONE_MEGABYTE)      // bytes per write, a multiple of any block size
+#define PATTERN_BUFFER_COUNT                2                       // one buffer is written while the other is filled
+#define PATTERN_SLICE_SIZE                  (ONE_MEGABYTE)          // bytes filled by a pool thread at a time
+#define PATTERN_MAX_FILL_THREADS            (PATTERN_BUFFER_SIZE / PATTERN_SLICE_SIZE)
+#define PATTERN_FILL_STRIDE                 64                      // bytes stored per iteration of the vector fill
+#define PROGRESS_INTERVAL_MS                250                     // minimum time between two progress lines
+
+typedef struct _WRITE_PROGRESS
+{ // Throttles the "Mbytes written" line to one every PROGRESS_INTERVAL_MS
+    ULONGLONG       startTick;
+    ULONGLONG       lastTick;
+    UINT32          spin;
+} WRITE_PROGRESS, *PWRITE_PROGRESS;
+
+typedef struct _PATTERN_FILL_POOL
+{ // Threads filling the slices of one buffer, the buffer is done when slicesLeft reaches 0
+    HANDLE          workSemaphore;
+    HANDLE          doneEvent;
+    HANDLE          threads[PATTERN_MAX_FILL_THREADS];
+    UINT32          threadCount;
+    volatile BOOL   shutdown;
+
+    PCHAR           buffer;
+    size_t          bufferSize;
+    ULONGLONG       fileOffset;
+    volatile LONG   nextSlice;
+    volatile LONG   slicesLeft;
+} PATTERN_FILL_POOL, *PPATTERN_FILL_POOL;
+
+void    FillPattern(_Out_writes_bytes_(size) PCHAR buffer, _In_ size_t size, _In_ ULONGLONG fileOffset);
+HRESULT WritePatternAt(_Inout_ DEVICE_IO *oFile, _In_ ULONGLONG fileOffset, _In_ ULARGE_INTEGER writeSize, _Out_ ULARGE_INTEGER *bytesWritten);
+HRESULT WriteZeros(_Inout_ DEVICE_IO *oFile, _In_ ULARGE_INTEGER writeSize, _Out_ ULARGE_INTEGER *bytesWritten);
+HRESULT WriteSparse(_Inout_ DEVICE_IO *oFile, _In_ ULONGLONG beginOffset, _In_ ULONGLONG endOffset);
@@ -0,0 +1,1031 @@
+/*++
+
+Copyright (C) Microsoft. All rights reserved.
+
+Module Name:
+    synthDump.cpp
+
+Environment:
+    User Mode
+
+--*/
+
+#include <nt.h>
+#include <ntrtl.h>
+#include <nturtl.h>
+
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+
+#include "synthDump.h"
+
+#include <wdbgexts.h>
+#include <ntiodump.h>
+
+#include "Device_Specific.h"
+#include "Dump_Magic.h"
+#include "KdDebuggerData.h"
+#include "Kd_Decode.h"
+
+#define SYNTH_DUMP_MAJOR_VERSION            0xF                     // free build
+#define SYNTH_DUMP_MINOR_VERSION            10586
+
+#define SYNTH_PTE_VALID                     0x1
+#define SYNTH_PTE_WRITE_OR_TABLE            0x2                     // x86 R/W, ARM64 table or page descriptor (NotLargePage)
+#define SYNTH_PTE_ARM64_ACCESSED            0x400
+
+#define SYNTH_MAX_RUNS32                    ((RTL_FIELD_SIZE(DUMP_HEADER32, PhysicalMemoryBlockBuffer) - FIELD_OFFSET(PHYSICAL_MEMORY_DESCRIPTOR32, Run)) / sizeof(PHYSICAL_MEMORY_RUN32))
+#define SYNTH_MAX_RUNS64                    ((RTL_FIELD_SIZE(DUMP_HEADER64, PhysicalMemoryBlockBuffer) - FIELD_OFFSET(PHYSICAL_MEMORY_DESCRIPTOR64, Run)) / sizeof(PHYSICAL_MEMORY_RUN64))
+
+// Legacy AP_REG (rawdump.h), written for ARM
+#define SYNTH_APREG_MAGIC                   0x44434151              // AP_REG_STRUCTURE_MAGIC_VALUE
+#define SYNTH_APREG_VERSION                 0x2                     // AP_REG_STRUCTURE_VERSION_2
+#define SYNTH_APREG_MAX_CPUS                4
+#define SYNTH_APREG_HEADER_WORDS            3                       // Magic, Version, CPU_Count
+#define SYNTH_APREG_SECURE_WORDS            37                      // SECURE_CPU_CONTEXT
+#define SYNTH_APREG_NON_SECURE_WORDS        (SYNTH_APREG_SECURE_WORDS + 2)  // + Mon_Sp, Wdog_Pc
+#define SYNTH_APREG_MON_LR                  0
+#define SYNTH_APREG_MON_SPSR                1
+#define SYNTH_APREG_SVC_R13                 21
+#define SYNTH_APREG_WDOG_PC                 38
+#define SYNTH_APREG_SC_STATUS               0x3                     // SC_STATUS_NS | SC_STATUS_WDT
+#define SYNTH_ARM_SVC_MODE                  0x13
+
+// MSM dump table AP_REG (apreg64.h), written for ARM64
+#define SYNTH_MSM_TABLE_VERSION_ARM64       0x00200000
+#define SYNTH_MSM_DATA_VERSION              0x11
+#define SYNTH_MSM_DATA_MAGIC                0x42445953
+#define SYNTH_MSM_TYPE_DATA                 0
+#define SYNTH_MSM_CPU_STATUS                0x1                     // CPU_STATUS_A53
+#define SYNTH_MSM_WDT_STATUS                0x2                     // NS_WDT_BITE_PROMTPED_DUMP
+#define SYNTH_MSM_ALIGNMENT                 64
+#define SYNTH_MSM_CPU64_REGS                47                      // SDI_CPU64_CTXT_REGS_TYPE
+#define SYNTH_MSM_PC                        31
+#define SYNTH_MSM_CURRENT_EL                32
+#define SYNTH_MSM_SP_EL1                    39
+#define SYNTH_MSM_ELR_EL1                   40
+#define SYNTH_MSM_SPSR_EL1                  41
+#define SYNTH_ARM64_EL1                     (1 << 2)
+#define SYNTH_ARM64_EL1H_MASKED             0x3C5
+
+typedef struct _SYNTH_MSM_DUMP_ENTRY
+{ // AP_REG_MSM_DUMP_ENTRY
+    UINT32          id;
+    UINT8           name[32];
+    UINT32          type;
+    ULONGLONG       address;
+} SYNTH_MSM_DUMP_ENTRY, *PSYNTH_MSM_DUMP_ENTRY;
+
+typedef struct _SYNTH_MSM_DUMP_TABLE
+{ // AP_REG_MSM_DUMP_TABLE, the entries follow
+    UINT32          version;
+    UINT32          numEntries;
+} SYNTH_MSM_DUMP_TABLE, *PSYNTH_MSM_DUMP_TABLE;
+
+typedef struct _SYNTH_MSM_DUMP_DATA
+{ // AP_REG_MSM_DUMP_DATA
+    UINT32          version;
+    UINT32          magic;
+    UINT8           name[32];
+    ULONGLONG       address;
+    ULONGLONG       len;
+    ULONGLONG       reserved;
+} SYNTH_MSM_DUMP_DATA, *PSYNTH_MSM_DUMP_DATA;
+
+typedef struct _SYNTH_MSM_CPU_CONTEXT
+{ // SDICPUCtxtType with the 64 bit registers
+    UINT32          status[4];
+    ULONGLONG       regs[SYNTH_MSM_CPU64_REGS];
+    ULONGLONG       reserved[SYNTH_MSM_CPU64_REGS];
+} SYNTH_MSM_CPU_CONTEXT, *PSYNTH_MSM_CPU_CONTEXT;
+
+C_ASSERT(48 == sizeof(SYNTH_MSM_DUMP_ENTRY));
+C_ASSERT(64 == sizeof(SYNTH_MSM_DUMP_DATA));
+C_ASSERT(768 == sizeof(SYNTH_MSM_CPU_CONTEXT));
+
+C_ASSERT((sizeof(InMemoryDumpHeaderMagicString) + sizeof(DUMP_HEADER64)) <= (SYNTH_HEADER_PAGES * SYNTH_PAGE_SIZE));
+C_ASSERT((sizeof(InMemoryDumpHeaderMagicString) + SYNTH_PAGE_SIZE + sizeof(KDDEBUGGER_DATA64) + sizeof(ULONGLONG)) <= (SYNTH_HEADER_PAGES * SYNTH_PAGE_SIZE));
+C_ASSERT(sizeof(KDDEBUGGER_DATA64) <= SYNTH_BUGCHECK_DATA_OFFSET);
+C_ASSERT((SYNTH_BUGCHECK_DATA_OFFSET + DBG_BUGCHECK_SIZE) <= SYNTH_ENCODED_FLAG_OFFSET);
+
+
+/****************************************************************************************************
+** ULONGLONG SynthRandom(_Inout_ PSYNTH_STATE st)
+**
+** Description:
+**  splitmix64, 64 random bits from the seed on every compiler (rand() only gives 15 on MSVC).
+**
+*****************************************************************************************************/
+static ULONGLONG SynthRandom(_Inout_ PSYNTH_STATE st)
+{
+    ULONGLONG z = (st->random += 0x9E3779B97F4A7C15ULL);
+
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+
+    return z ^ (z >> 31);
+}
+
+
+/****************************************************************************************************
+** ULONGLONG SynthPointer(_In_ PDUMP_CONFIG cfg, _In_ ULONGLONG va)
+**
+** Description:
+**  Pointer as stored in the KdDebuggerDataBlock, sign extended on 32 bit targets.
+**
+*****************************************************************************************************/
+static ULONGLONG SynthPointer(_In_ PDUMP_CONFIG cfg, _In_ ULONGLONG va)
+{
+    return (SYNTH_ARCH_ARM64 == cfg->synthArch) ? va : (ULONGLONG)(LONGLONG)(LONG)(ULONG)va;
+}
+
+
+/****************************************************************************************************
+** HRESULT SynthCarveRuns(
+**          _In_ PDUMP_CONFIG cfg,
+**          _Inout_ PSYNTH_STATE st,
+**          _In_ UINT32 maxRuns,
+**          _In_ ULONGLONG runLimitPA)
+**
+** Description:
+**  Carves the PhysicalMemoryBlock runs out of the DDR sections.  cfg->synthRuns are shared out
+**  in proportion to the section sizes and each section gets at least one run, but for the
+**  sections (or parts) at or above runLimitPA, those smaller than a page or overlapping an
+**  earlier one, and those left once the DUMP_HEADER holds maxRuns runs.  A section with several
+**  runs is split in equal slots of at least SYNTH_MIN_RUN_PAGES pages and each run starts after
+**  a random hole of up to a quarter of its slot, the holes are the memory the OS did not own.
+**
+** Arguments:
+**  cfg - dump file configuration data
+**  st - synthesis state, runs and runPages are set
+**  maxRuns - runs that fit in the DUMP_HEADER
+**  runLimitPA - runs end below this physical address
+**
+** Return:
+**  HRESULT
+**
+*****************************************************************************************************/
+static HRESULT SynthCarveRuns(_In_ PDUMP_CONFIG cfg, _Inout_ PSYNTH_STATE st, _In_ UINT32 maxRuns, _In_ ULONGLONG runLimitPA)
+{
+    HRESULT                 hr = S_OK;
+    std::vector<SYNTH_RUN>  sections;
+    ULONGLONG               totalPages = 0;
+    ULONGLONG               lastPage = 0;
+    UINT32                  requested = min(max(cfg->synthRuns, 1), maxRuns);
+
+    for (size_t i = 0; i < cfg->sectionDDR.size(); i++)
+    { // Whole pages of each DDR section, below the limit
+        ULONGLONG   firstPage = (cfg->sectionDDR[i]->u.DDRInformation.Base + SYNTH_PAGE_SIZE - 1) >> SYNTH_PAGE_SHIFT;
+        ULONGLONG   endPage = min(cfg->sectionDDR[i]->u.DDRInformation.Base + cfg->sectionDDR[i]->Size, runLimitPA) >> SYNTH_PAGE_SHIFT;
+
+        if (endPage > firstPage)
+        {
+            SYNTH_RUN   section = { firstPage, endPage - firstPage };
+
+            sections.push_back(section);
+        }
+
+    }
+
+    std::sort(sections.begin(), sections.end(), [](const SYNTH_RUN &a, const SYNTH_RUN &b) { return a.basePage < b.basePage; });
+
+    st->runs.clear();
+    st->runPages = 0;
+
+    for (size_t i = 0; i < sections.size(); i++)
+    { // Overlapping sections (/DDROverlap) cannot be described by runs, keep the first one
+        if (sections[i].basePage >= lastPage)
+        {
+            totalPages += sections[i].pageCount;
+            lastPage = sections[i].basePage + sections[i].pageCount;
+        }
+        else
+        {
+            sections[i].pageCount = 0;
+        }
+
+    }
+
+    for (size_t i = 0; (i < sections.size()) && (st->runs.size() < maxRuns); i++)
+    {
+        ULONGLONG   pages = sections[i].pageCount;
+        ULONGLONG   count = (0 != totalPages) ? ((requested * pages) / totalPages) : 0;
+
+        if (0 == pages)
+        { // overlapping section
+            continue;
+        }
+
+        count = max(min(count, pages / SYNTH_MIN_RUN_PAGES), 1);
+        count = min(count, maxRuns - st->runs.size());
+
+        for (ULONGLONG j = 0; j < count; j++)
+        {
+            ULONGLONG   slot = pages / count;
+            ULONGLONG   length = (j == (count - 1)) ? (pages - (j * slot)) : slot;
+            ULONGLONG   hole = (count > 1) ? (SynthRandom(st) % ((length / 4) + 1)) : 0;
+            SYNTH_RUN   run = { sections[i].basePage + (j * slot) + hole, length - hole };
+
+            st->runs.push_back(run);
+            st->runPages += run.pageCount;
+        }
+
+    }
+
+    if (st->runs.empty())
+    {
+        printf("ERROR: no DDR section can hold a physical memory run\r\n");
+        hr = E_FAIL;
+    }
+
+    return hr;
+}
+
+
+/****************************************************************************************************
+** BOOL SynthPagesFree(_In_ PSYNTH_STATE st, _In_ ULONGLONG page, _In_ ULONGLONG pageCount)
+**
+** Description:
+**  TRUE when the pages are below the structure limit and not used yet.
+**
+*****************************************************************************************************/
+static BOOL SynthPagesFree(_In_ PSYNTH_STATE st, _In_ ULONGLONG page, _In_ ULONGLONG pageCount)
+{
+    BOOL    isFree = (((page + pageCount) << SYNTH_PAGE_SHIFT) <= st->paLimit);
+
+    for (size_t i = 0; isFree && (i < st->allocated.size()); i++)
+    {
+        isFree = ((page + pageCount) <= st->allocated[i].basePage) ||
+                 (page >= (st->allocated[i].basePage + st->allocated[i].pageCount));
+    }
+
+    return isFree;
+}
+
+
+/****************************************************************************************************
+** HRESULT SynthAllocPages(
+**          _Inout_ PSYNTH_STATE st,
+**          _In_ ULONGLONG pageCount,
+**          _Out_ PULONGLONG pa)
+**
+** Description:
+**  Places pageCount contiguous pages at a random spot of a random run, falls back to the first
+**  free spot when SYNTH_ALLOC_TRIES random spots were taken.
+**
+** Arguments:
+**  st - synthesis state
+**  pageCount - number of pages
+**  pa - physical address of the first page
+**
+** Return:
+**  HRESULT
+**
+*****************************************************************************************************/
+static HRESULT SynthAllocPages(_Inout_ PSYNTH_STATE st, _In_ ULONGLONG pageCount, _Out_ PULONGLONG pa)
+{
+    HRESULT     hr = E_OUTOFMEMORY;
+    ULONGLONG   page = 0;
+
+    *pa = 0;
+
+    for (UINT32 tries = 0; FAILED(hr) && (tries < SYNTH_ALLOC_TRIES); tries++)
+    {
+        SYNTH_RUN   run = st->runs[(size_t)(SynthRandom(st) % st->runs.size())];
+
+        if (run.pageCount >= pageCount)
+        {
+            page = run.basePage + (SynthRandom(st) % (run.pageCount - pageCount + 1));
+            hr = SynthPagesFree(st, page, pageCount) ? S_OK : E_OUTOFMEMORY;
+        }
+
+    }
+
+    for (size_t i = 0; FAILED(hr) && (i < st->runs.size()); i++)
+    { // linear search, stop at the end of the run or at the limit
+        for (page = st->runs[i].basePage;
+             FAILED(hr) &&
+             ((page + pageCount) <= (st->runs[i].basePage + st->runs[i].pageCount)) &&
+             (((page + pageCount) << SYNTH_PAGE_SHIFT) <= st->paLimit);
+             page++)
+        {
+            hr = SynthPagesFree(st, page, pageCount) ? S_OK : E_OUTOFMEMORY;
+        }
+
+        page--;
+    }
+
+    if (SUCCEEDED(hr))
+    {
+        SYNTH_RUN   range = { page, pageCount };
+
+        st->allocated.push_back(range);
+        *pa = page << SYNTH_PAGE_SHIFT;
+    }
+    else
+    {
+        printf("ERROR: no room for %lld pages in the physical memory runs\r\n", pageCount);
+    }
+
+    return hr;
+}
+
+
+/****************************************************************************************************
+** ULONGLONG SynthRandomPage(_Inout_ PSYNTH_STATE st)
+**
+** Description:
+**  Physical address of a random page of a random run, below the structure limit.  Used for the
+**  kernel window pages that hold nothing raw2dump reads, so they are not reserved.
+**
+*****************************************************************************************************/
+static ULONGLONG SynthRandomPage(_Inout_ PSYNTH_STATE st)
+{
+    ULONGLONG   pa = st->kdbgPagePA;
+
+    for (UINT32 tries = 0; tries < SYNTH_ALLOC_TRIES; tries++)
+    {
+        SYNTH_RUN   run = st->runs[(size_t)(SynthRandom(st) % st->runs.size())];
+        ULONGLONG   page = run.basePage + (SynthRandom(st) % run.pageCount);
+
+        if (((page + 1) << SYNTH_PAGE_SHIFT) <= st->paLimit)
+        {
+            pa = page << SYNTH_PAGE_SHIFT;
+            break;
+        }
+
+    }
+
+    return pa;
+}
+
+
+/****************************************************************************************************
+** HRESULT SynthWrite(
+**          _Inout_ DEVICE_IO *oFile,
+**          _In_ PDUMP_CONFIG cfg,
+**          _In_ ULONGLONG pa,
+**          _In_reads_bytes_(size) const VOID *buffer,
+**          _In_ size_t size)
+**
+** Description:
+**  Writes buffer at physical address pa, that is at the offset of pa in the DDR section that
+**  holds it.
+**
+** Arguments:
+**  oFile - output file or partition
+**  cfg - dump file configuration data, with the section offsets set
+**  pa - physical address
+**  buffer - data to write
+**  size - bytes to write, the range may not cross a DDR section end
+**
+** Return:
+**  HRESULT
+**
+*****************************************************************************************************/
+static HRESULT SynthWrite(_Inout_ DEVICE_IO *oFile, _In_ PDUMP_CONFIG cfg, _In_ ULONGLONG pa, _In_reads_bytes_(size) const VOID *buffer, _In_ size_t size)
+{
+    HRESULT     hr = E_INVALIDARG;
+    ULONGLONG   offset = 0;
+    size_t      bytesWritten = 0;
+
+    for (size_t i = 0; i < cfg->sectionDDR.size(); i++)
+    {
+        ULONGLONG   base = cfg->sectionDDR[i]->u.DDRInformation.Base;
+
+        if ((pa >= base) && ((pa + size) <= (base + cfg->sectionDDR[i]->Size)))
+        {
+            offset = cfg->sectionDDR[i]->Offset + (pa - base);
+            hr = S_OK;
+            break;
+        }
+
+    }
+
+    if (FAILED(hr))
+    {
+        printf("ERROR: physical address %#I64x is not in a DDR section\r\n", pa);
+    }
+    else if (FAILED(hr = oFile->SetPos(offset)))
+    {
+        printf("ERROR: cannot seek to %#I64x, (%#lx)\r\n", offset, hr);
+    }
+    else if (FAILED(hr = oFile->Write((PCHAR)buffer, size, &bytesWritten)))
+    {
+        printf("ERROR: failed to write %#I64x, (%#lx)\r\n", pa, hr);
+    }
+    else if (size != bytesWritten)
+    {
+        printf("ERROR: incomplete write at %#I64x\r\n", pa);
+        hr = E_FAIL;
+    }
+
+    return hr;
+}
+
+
+/****************************************************************************************************
+** HRESULT SynthWritePageTables(
+**          _Inout_ DEVICE_IO *oFile,
+**          _In_ PDUMP_CONFIG cfg,
+**          _Inout_ PSYNTH_STATE st)
+**
+** Description:
+**  Writes one table per level mapping the SYNTH_KERNEL_PAGES pages of the kernel window:
+**    X86, ARM   : page directory, page table of 4 byte entries
+**    X86PAE     : page directory pointer table, page directory, page table of 8 byte entries
+**    ARM64      : 4 levels of 8 byte entries
+**  The window starts on a last level table boundary.  The KdDebuggerDataBlock page is mapped at
+**  kdbgWindowIndex, the other pages map random pages of the runs.  Entries are valid and
+**  writable, never large pages.
+**
+** Arguments:
+**  oFile - output file or partition
+**  cfg - dump file configuration data
+**  st - synthesis state, directoryTableBase is set
+**
+** Return:
+**  HRESULT
+**
+*****************************************************************************************************/
+static HRESULT SynthWritePageTables(_Inout_ DEVICE_IO *oFile, _In_ PDUMP_CONFIG cfg, _Inout_ PSYNTH_STATE st)
+{
+    static const UINT32     shifts32[] = { 22, 12 };
+    static const UINT32     shiftsPAE[] = { 30, 21, 12 };
+    static const UINT32     shifts64[] = { 39, 30, 21, 12 };
+    static const ULONGLONG  masks32[] = { 0x3ff, 0x3ff };
+    static const ULONGLONG  masksPAE[] = { 0x3, 0x1ff, 0x1ff };
+    static const ULONGLONG  masks64[] = { 0x1ff, 0x1ff, 0x1ff, 0x1ff };
+
+    HRESULT                 hr = S_OK;
+    const UINT32            *shifts = shifts32;
+    const ULONGLONG         *masks = masks32;
+    UINT32                  levels = ArrayCount(shifts32);
+    size_t                  entrySize = sizeof(UINT32);
+    ULONGLONG               tableFlags = SYNTH_PTE_VALID | SYNTH_PTE_WRITE_OR_TABLE;
+    ULONGLONG               pageFlags = SYNTH_PTE_VALID | SYNTH_PTE_WRITE_OR_TABLE;
+    ULONGLONG               tables[SYNTH_MAX_TABLE_LEVELS] = { 0 };
+    std::vector<UCHAR>      page(SYNTH_PAGE_SIZE);
+
+    if (SYNTH_ARCH_X86PAE == cfg->synthArch)
+    {
+        shifts = shiftsPAE;
+        masks = masksPAE;
+        levels = ArrayCount(shiftsPAE);
+        entrySize = sizeof(ULONGLONG);
+    }
+    else if (SYNTH_ARCH_ARM64 == cfg->synthArch)
+    {
+        shifts = shifts64;
+        masks = masks64;
+        levels = ArrayCount(shifts64);
+        entrySize = sizeof(ULONGLONG);
+        pageFlags |= SYNTH_PTE_ARM64_ACCESSED;
+    }
+
+    for (UINT32 level = 0; SUCCEEDED(hr) && (level < levels); level++)
+    {
+        hr = SynthAllocPages(st, 1, &tables[level]);
+    }
+
+    for (UINT32 level = 0; SUCCEEDED(hr) && (level < levels); level++)
+    {
+        ULONGLONG   index = (st->kernelVA >> shifts[level]) & masks[level];
+        UINT32      count = (level == (levels - 1)) ? SYNTH_KERNEL_PAGES : 1;
+
+        memset(&page[0], 0, page.size());
+
+        for (UINT32 i = 0; i < count; i++)
+        { // one entry to the next level table, or the pages of the window in the last one
+            ULONGLONG   entry = (level != (levels - 1)) ? (tables[level + 1] | tableFlags) :
+                                (((i == st->kdbgWindowIndex) ? st->kdbgPagePA : SynthRandomPage(st)) | pageFlags);
+
+            if (sizeof(UINT32) == entrySize)
+            {
+                ((PUINT32)&page[0])[index + i] = (UINT32)entry;
+            }
+            else
+            {
+                ((PULONGLONG)&page[0])[index + i] = entry;
+            }
+
+        }
+
+        hr = SynthWrite(oFile, cfg, tables[level], &page[0], page.size());
+    }
+
+    st->directoryTableBase = tables[0];
+
+    return hr;
+}
+
+
+/****************************************************************************************************
+** ULONG SynthEncodeUlong(_In_ ULONG value, _In_ const KD_DECODE_KEYS *keys, _In_ ULONG salt)
+**
+** Description:
+**  Inverse of KdDecodeUlong: xor with KiWaitAlways, byte swap, xor with the salt, rotate right
+**  by KiWaitNever, xor with KiWaitNever.
+**
+*****************************************************************************************************/
+static ULONG SynthEncodeUlong(_In_ ULONG value, _In_ const KD_DECODE_KEYS *keys, _In_ ULONG salt)
+{
+    value = _byteswap_ulong(value ^ (ULONG)keys->WaitAlways) ^ salt;
+
+    return _rotr(value, (int)(keys->WaitNever & 31)) ^ (ULONG)keys->WaitNever;
+}
+
+
+/****************************************************************************************************
+** HRESULT SynthWriteKdbg(
+**          _Inout_ DEVICE_IO *oFile,
+**          _In_ PDUMP_CONFIG cfg,
+**          _Inout_ PSYNTH_STATE st,
+**          _Out_ PKDDEBUGGER_DATA64 decoded)
+**
+** Description:
+**  Writes the page of the KdDebuggerDataBlock: the block, KiBugcheckData and, when /EncodeKdbg,
+**  KdpDataBlockEncoded and the keys.  The encoded block is decoded back with KdDecodeBlock
+**  before it is written.
+**
+** Arguments:
+**  oFile - output file or partition
+**  cfg - dump file configuration data
+**  st - synthesis state, the keys and salt are set
+**  decoded - the decoded block, for the copy after the DUMP_HEADER
+**
+** Return:
+**  HRESULT
+**
+*****************************************************************************************************/
+static HRESULT SynthWriteKdbg(_Inout_ DEVICE_IO *oFile, _In_ PDUMP_CONFIG cfg, _Inout_ PSYNTH_STATE st, _Out_ PKDDEBUGGER_DATA64 decoded)
+{
+    HRESULT             hr = S_OK;
+    std::vector<UCHAR>  page(SYNTH_PAGE_SIZE, 0);
+    PKDDEBUGGER_DATA64  kdbg = (PKDDEBUGGER_DATA64)&page[0];
+    PUINT               bugcheck = (PUINT)&page[SYNTH_BUGCHECK_DATA_OFFSET];
+
+    kdbg->Header.List.Flink = SynthPointer(cfg, st->kdbgVA);
+    kdbg->Header.List.Blink = SynthPointer(cfg, st->kdbgVA);
+    kdbg->Header.OwnerTag = KDBG_TAG;
+    kdbg->Header.Size = sizeof(KDDEBUGGER_DATA64);
+    kdbg->KernBase = SynthPointer(cfg, st->kernelVA);
+    kdbg->KiBugcheckData = SynthPointer(cfg, st->kdbgVA + SYNTH_BUGCHECK_DATA_OFFSET);
+
+    bugcheck[BUGCHECK_CODE_IDX] = FATAL_ABNORMAL_RESET_ERROR;
+    bugcheck[BUGCHECK_PARAM1_IDX] = (UINT)ONEFOURC_PARAM1_DEFAULT;
+    bugcheck[BUGCHECK_PARAM2_IDX] = (UINT)ONEFOURC_PARAM2_DEFAULT;
+    bugcheck[BUGCHECK_PARAM3_IDX] = (UINT)ONEFOURC_PARAM3_DEFAULT;
+    bugcheck[BUGCHECK_PARAM4_IDX] = (UINT)ONEFOURC_PARAM4_DEFAULT;
+
+    *decoded = *kdbg;
+
+    if (cfg->synthEncodeKdbg)
+    { // Encode as the kernel does, salted with the address of KdpDataBlockEncoded
+        KD_DECODE_KEYS      keys;
+        KDDEBUGGER_DATA64   check;
+
+        st->waitNever = SynthRandom(st);
+        st->waitAlways = SynthRandom(st);
+        st->salt = (ULONG)(st->kdbgVA + SYNTH_ENCODED_FLAG_OFFSET);
+        keys.WaitNever = st->waitNever;
+        keys.WaitAlways = st->waitAlways;
+
+        page[SYNTH_ENCODED_FLAG_OFFSET] = TRUE;
+        memcpy(&page[SYNTH_WAIT_NEVER_OFFSET], &st->waitNever, sizeof(st->waitNever));
+        memcpy(&page[SYNTH_WAIT_ALWAYS_OFFSET], &st->waitAlways, sizeof(st->waitAlways));
+
+        for (size_t i = 0; i < (sizeof(KDDEBUGGER_DATA64) / sizeof(ULONG)); i++)
+        {
+            ((PULONG)kdbg)[i] = SynthEncodeUlong(((PULONG)kdbg)[i], &keys, st->salt);
+        }
+
+        KdDecodeBlock(kdbg, &check, sizeof(check), &keys, st->salt);
+        if (0 != memcmp(&check, decoded, sizeof(check)))
+        {
+            printf("ERROR: the encoded KdDebuggerDataBlock does not decode\r\n");
+            hr = E_UNEXPECTED;
+        }
+
+    }
+
+    if (SUCCEEDED(hr))
+    {
+        hr = SynthWrite(oFile, cfg, st->kdbgPagePA, &page[0], page.size());
+    }
+
+    return hr;
+}
+
+
+/****************************************************************************************************
+** HRESULT SynthWriteHeader(
+**          _Inout_ DEVICE_IO *oFile,
+**          _In_ PDUMP_CONFIG cfg,
+**          _In_ PSYNTH_STATE st,
+**          _In_ const KDDEBUGGER_DATA64 *decoded)
+**
+** Description:
+**  Writes the magic string and the DUMP_HEADER32 or DUMP_HEADER64 after it.  The header is filled
+**  with DUMP_SIGNATURE32 first, like the kernel does, so RequiredDumpSpace and the fields not set
+**  here hold the signature.  The decoded KdDebuggerDataBlock goes one page after the header,
+**  followed by the physical address of the original block.
+**
+** Arguments:
+**  oFile - output file or partition
+**  cfg - dump file configuration data
+**  st - synthesis state
+**  decoded - decoded KdDebuggerDataBlock
+**
+** Return:
+**  HRESULT
+**
+*****************************************************************************************************/
+static HRESULT SynthWriteHeader(_Inout_ DEVICE_IO *oFile, _In_ PDUMP_CONFIG cfg, _In_ PSYNTH_STATE st, _In_ const KDDEBUGGER_DATA64 *decoded)
+{
+    std::vector<UCHAR>  block(SYNTH_HEADER_PAGES * SYNTH_PAGE_SIZE, 0);
+    PUCHAR              header = &block[sizeof(InMemoryDumpHeaderMagicString)];
+    BOOL                is64 = (SYNTH_ARCH_ARM64 == cfg->synthArch);
+    size_t              headerSize = is64 ? sizeof(DUMP_HEADER64) : sizeof(DUMP_HEADER32);
+
+    memcpy(&block[0], InMemoryDumpHeaderMagicString, sizeof(InMemoryDumpHeaderMagicString));
+
+    for (size_t i = 0; i < (headerSize / sizeof(ULONG)); i++)
+    {
+        ((PULONG)header)[i] = DUMP_SIGNATURE32;
+    }
+
+    if (is64)
+    {
+        PDUMP_HEADER64          dh = (PDUMP_HEADER64)header;
+        PPHYSICAL_MEMORY_RUN64  run = &dh->PhysicalMemoryBlock.Run[0];
+
+        dh->ValidDump = DUMP_VALID_DUMP64;
+        dh->MajorVersion = SYNTH_DUMP_MAJOR_VERSION;
+        dh->MinorVersion = SYNTH_DUMP_MINOR_VERSION;
+        dh->DirectoryTableBase = st->directoryTableBase;
+        dh->MachineImageType = IMAGE_FILE_MACHINE_ARM64;
+        dh->NumberProcessors = cfg->CoreCount;
+        dh->BugCheckCode = FATAL_ABNORMAL_RESET_ERROR;
+        dh->BugCheckParameter1 = (ULONG64)ONEFOURC_PARAM1_DEFAULT;
+        dh->BugCheckParameter2 = ONEFOURC_PARAM2_DEFAULT;
+        dh->BugCheckParameter3 = ONEFOURC_PARAM3_DEFAULT;
+        dh->BugCheckParameter4 = (ULONG64)ONEFOURC_PARAM4_DEFAULT;
+        dh->KdDebuggerDataBlock = st->kdbgVA;
+        dh->DumpType = DUMP_TYPE_FULL;
+        memcpy(dh->Comment, &st->instanceID, sizeof(st->instanceID));
+
+        dh->PhysicalMemoryBlock.NumberOfRuns = (ULONG)st->runs.size();
+        dh->PhysicalMemoryBlock.NumberOfPages = st->runPages;
+        for (size_t i = 0; i < st->runs.size(); i++)
+        {
+            run[i].BasePage = st->runs[i].basePage;
+            run[i].PageCount = st->runs[i].pageCount;
+        }
+
+    }
+    else
+    {
+        PDUMP_HEADER32          dh = (PDUMP_HEADER32)header;
+        PPHYSICAL_MEMORY_RUN32  run = &dh->PhysicalMemoryBlock.Run[0];
+
+        dh->ValidDump = DUMP_VALID_DUMP32;
+        dh->MajorVersion = SYNTH_DUMP_MAJOR_VERSION;
+        dh->MinorVersion = SYNTH_DUMP_MINOR_VERSION;
+        dh->DirectoryTableBase = (ULONG)st->directoryTableBase;
+        dh->MachineImageType = (SYNTH_ARCH_ARM == cfg->synthArch) ? IMAGE_FILE_MACHINE_ARMNT : IMAGE_FILE_MACHINE_I386;
+        dh->NumberProcessors = cfg->CoreCount;
+        dh->BugCheckCode = FATAL_ABNORMAL_RESET_ERROR;
+        dh->BugCheckParameter1 = (ULONG)ONEFOURC_PARAM1_DEFAULT;
+        dh->BugCheckParameter2 = ONEFOURC_PARAM2_DEFAULT;
+        dh->BugCheckParameter3 = ONEFOURC_PARAM3_DEFAULT;
+        dh->BugCheckParameter4 = (ULONG)ONEFOURC_PARAM4_DEFAULT;
+        dh->PaeEnabled = (SYNTH_ARCH_X86PAE == cfg->synthArch);
+        dh->KdDebuggerDataBlock = (ULONG)st->kdbgVA;
+        dh->DumpType = DUMP_TYPE_FULL;
+        memcpy(dh->Comment, &st->instanceID, sizeof(st->instanceID));
+
+        dh->PhysicalMemoryBlock.NumberOfRuns = (ULONG)st->runs.size();
+        dh->PhysicalMemoryBlock.NumberOfPages = (ULONG)st->runPages;
+        for (size_t i = 0; i < st->runs.size(); i++)
+        {
+            run[i].BasePage = (ULONG)st->runs[i].basePage;
+            run[i].PageCount = (ULONG)st->runs[i].pageCount;
+        }
+
+    }
+
+    memcpy(header + SYNTH_PAGE_SIZE, decoded, sizeof(KDDEBUGGER_DATA64));
+    memcpy(header + SYNTH_PAGE_SIZE + sizeof(KDDEBUGGER_DATA64), &st->kdbgPagePA, sizeof(st->kdbgPagePA));
+
+    return SynthWrite(oFile, cfg, st->headerPA, &block[0], block.size());
+}
+
+
+/****************************************************************************************************
+** HRESULT SynthWriteApReg(
+**          _Inout_ DEVICE_IO *oFile,
+**          _In_ PDUMP_CONFIG cfg,
+**          _Inout_ PSYNTH_STATE st)
+**
+** Description:
+**  Writes the AP_REG data the CPU contexts are taken from.  ARM gets the legacy version 2 layout
+**  (header, CPU_STATUS[], NON_SECURE_CPU_CONTEXT[], SECURE_CPU_CONTEXT, WDOG_STATUS[]) for up to
+**  4 cores, ARM64 an MSM dump table with one CPU context data entry per core.  The registers are
+**  random, the program counters and stacks point into the kernel window.
+**
+** Arguments:
+**  oFile - output file or partition
+**  cfg - dump file configuration data
+**  st - synthesis state, apRegPA is set
+**
+** Return:
+**  HRESULT
+**
+*****************************************************************************************************/
+static HRESULT SynthWriteApReg(_Inout_ DEVICE_IO *oFile, _In_ PDUMP_CONFIG cfg, _Inout_ PSYNTH_STATE st)
+{
+    HRESULT             hr = S_OK;
+    BOOL                is64 = (SYNTH_ARCH_ARM64 == cfg->synthArch);
+    UINT32              cpus = is64 ? max(cfg->CoreCount, 1) : min(max(cfg->CoreCount, 1), SYNTH_APREG_MAX_CPUS);
+    size_t              tableSize = sizeof(SYNTH_MSM_DUMP_TABLE) + (cpus * sizeof(SYNTH_MSM_DUMP_ENTRY));
+    size_t              dataOffset = (tableSize + SYNTH_MSM_ALIGNMENT - 1) & ~((size_t)SYNTH_MSM_ALIGNMENT - 1);
+    size_t              contextOffset = dataOffset + (cpus * sizeof(SYNTH_MSM_DUMP_DATA));
+    size_t              size = is64 ? (contextOffset + (cpus * sizeof(SYNTH_MSM_CPU_CONTEXT))) :
+                                      (sizeof(UINT32) * (SYNTH_APREG_HEADER_WORDS + SYNTH_APREG_SECURE_WORDS +
+                                                         (cpus * (1 + SYNTH_APREG_NON_SECURE_WORDS + 1))));
+    size_t              pages = (size + SYNTH_PAGE_SIZE - 1) / SYNTH_PAGE_SIZE;
+    std::vector<UCHAR>  buffer(pages * SYNTH_PAGE_SIZE, 0);
+    ULONGLONG           windowSize = SYNTH_KERNEL_PAGES * SYNTH_PAGE_SIZE;
+
+    if (FAILED(hr = SynthAllocPages(st, pages, &st->apRegPA)))
+    {
+        printf("ERROR: no room for AP_REG\r\n");
+    }
+    else if (is64)
+    { // table, then the data entries, then the contexts
+        PSYNTH_MSM_DUMP_TABLE   table = (PSYNTH_MSM_DUMP_TABLE)&buffer[0];
+        PSYNTH_MSM_DUMP_ENTRY   entry = (PSYNTH_MSM_DUMP_ENTRY)(table + 1);
+        PSYNTH_MSM_DUMP_DATA    data = (PSYNTH_MSM_DUMP_DATA)&buffer[dataOffset];
+        PSYNTH_MSM_CPU_CONTEXT  context = (PSYNTH_MSM_CPU_CONTEXT)&buffer[contextOffset];
+
+        table->version = SYNTH_MSM_TABLE_VERSION_ARM64;
+        table->numEntries = cpus;
+
+        for (UINT32 cpu = 0; cpu < cpus; cpu++)
+        {
+            entry[cpu].id = cpu;                    // MSM_DUMP_DATA_CPU_CTX, the low nibble is the processor
+            entry[cpu].type = SYNTH_MSM_TYPE_DATA;
+            entry[cpu].address = st->apRegPA + dataOffset + (cpu * sizeof(SYNTH_MSM_DUMP_DATA));
+
+            data[cpu].version = SYNTH_MSM_DATA_VERSION;
+            data[cpu].magic = SYNTH_MSM_DATA_MAGIC;
+            data[cpu].address = st->apRegPA + contextOffset + (cpu * sizeof(SYNTH_MSM_CPU_CONTEXT));
+            data[cpu].len = sizeof(SYNTH_MSM_CPU_CONTEXT);
+
+            context[cpu].status[0] = SYNTH_MSM_CPU_STATUS;
+            context[cpu].status[1] = SYNTH_MSM_WDT_STATUS;
+            for (UINT32 reg = 0; reg < SYNTH_MSM_CPU64_REGS; reg++)
+            {
+                context[cpu].regs[reg] = SynthRandom(st);
+            }
+
+            context[cpu].regs[SYNTH_MSM_PC] = st->kernelVA + ((SynthRandom(st) % windowSize) & ~3ULL);
+            context[cpu].regs[SYNTH_MSM_ELR_EL1] = context[cpu].regs[SYNTH_MSM_PC];
+            context[cpu].regs[SYNTH_MSM_SP_EL1] = st->kernelVA + ((SynthRandom(st) % windowSize) & ~15ULL);
+            context[cpu].regs[SYNTH_MSM_CURRENT_EL] = SYNTH_ARM64_EL1;
+            context[cpu].regs[SYNTH_MSM_SPSR_EL1] = SYNTH_ARM64_EL1H_MASKED;
+        }
+
+    }
+    else
+    { // header, CPU_STATUS[], NON_SECURE_CPU_CONTEXT[], SECURE_CPU_CONTEXT, WDOG_STATUS[]
+        PUINT32     words = (PUINT32)&buffer[0];
+        PUINT32     status = words + SYNTH_APREG_HEADER_WORDS;
+        PUINT32     nonSecure = status + cpus;
+        PUINT32     secure = nonSecure + (cpus * SYNTH_APREG_NON_SECURE_WORDS);
+        PUINT32     wdog = secure + SYNTH_APREG_SECURE_WORDS;
+
+        words[0] = SYNTH_APREG_MAGIC;
+        words[1] = SYNTH_APREG_VERSION;
+        words[2] = cpus;
+
+        for (PUINT32 word = nonSecure; word < wdog; word++)
+        {
+            *word = (UINT32)SynthRandom(st);
+        }
+
+        for (UINT32 cpu = 0; cpu < cpus; cpu++)
+        {
+            PUINT32 context = nonSecure + (cpu * SYNTH_APREG_NON_SECURE_WORDS);
+
+            status[cpu] = SYNTH_APREG_SC_STATUS;
+            wdog[cpu] = 0;
+            context[SYNTH_APREG_MON_LR] = (UINT32)(st->kernelVA + ((SynthRandom(st) % windowSize) & ~3ULL));
+            context[SYNTH_APREG_MON_SPSR] = SYNTH_ARM_SVC_MODE;
+            context[SYNTH_APREG_SVC_R13] = (UINT32)(st->kernelVA + ((SynthRandom(st) % windowSize) & ~7ULL));
+            context[SYNTH_APREG_WDOG_PC] = context[SYNTH_APREG_MON_LR];
+        }
+
+    }
+
+    if (SUCCEEDED(hr))
+    {
+        hr = SynthWrite(oFile, cfg, st->apRegPA, &buffer[0], buffer.size());
+    }
+
+    return hr;
+}
+
+
+/****************************************************************************************************
+** HRESULT SynthWriteDeviceSpecificInfo(
+**          _Inout_ DEVICE_IO *oFile,
+**          _In_ PDUMP_CONFIG cfg,
+**          _In_ PSYNTH_STATE st)
+**
+** Description:
+**  Writes the DEVICE_SPECIFIC_INFO raw2dump reads from the last DEVICE_SPECIFIC_INFO_BUFFER_LENGTH
+**  bytes: appended after the dump in a file, at the end of a partition.
+**
+** Arguments:
+**  oFile - output file or partition
+**  cfg - dump file configuration data
+**  st - synthesis state
+**
+** Return:
+**  HRESULT
+**
+*****************************************************************************************************/
+static HRESULT SynthWriteDeviceSpecificInfo(_Inout_ DEVICE_IO *oFile, _In_ PDUMP_CONFIG cfg, _In_ PSYNTH_STATE st)
+{
+    HRESULT                 hr = S_OK;
+    DEVICE_SPECIFIC_INFO    info = { 0 };
+    ULONGLONG               offset = cfg->dumpFileHeader.DumpSize;
+
+    info.DumpHeaderInstanceID = st->instanceID;
+    info.BugCheckCode = BUGCHECK_CODE;
+    info.BugCheckParam1 = (ULONG)ONEFOURC_PARAM1_DEFAULT;
+    info.BugCheckParam2 = ONEFOURC_PARAM2_DEFAULT;
+    info.BugCheckParam3 = ONEFOURC_PARAM3_DEFAULT;
+    info.BugCheckParam4 = (ULONG)ONEFOURC_PARAM4_DEFAULT;
+
+    if ((SYNTH_ARCH_X86 == cfg->synthArch) || (SYNTH_ARCH_X86PAE == cfg->synthArch))
+    { // the context comes from the CPU context section
+        info.Type = PROCESSOR_ARCHITECTURE_INTEL;
+    }
+    else
+    {
+        info.Type = (SYNTH_ARCH_ARM64 == cfg->synthArch) ? PROCESSOR_ARCHITECTURE_ARM64 : PROCESSOR_ARCHITECTURE_ARM;
+        info.APRegPA = st->apRegPA;
+    }
+
+    if (cfg->outputToPartition)
+    {
+        if (oFile->GetCurrentPartitionSize() < (cfg->dumpFileHeader.DumpSize + DEVICE_SPECIFIC_INFO_BUFFER_LENGTH))
+        {
+            printf("ERROR: no room for the device specific info after the payload\r\n");
+            hr = E_FAIL;
+        }
+        else
+        {
+            offset = oFile->GetCurrentPartitionSize() - DEVICE_SPECIFIC_INFO_BUFFER_LENGTH;
+        }
+
+    }
+
+    if (SUCCEEDED(hr) && FAILED(hr = WriteDeviceSpecificInfo(oFile, &info, offset)))
+    {
+        printf("ERROR: failed to write the device specific info, (%#lx)\r\n", hr);
+    }
+
+    return hr;
+}
+
+
+/****************************************************************************************************
+** HRESULT SynthesizeDump(
+**          _Inout_ DEVICE_IO *oFile,
+**          _In_ PDUMP_CONFIG cfg)
+**
+** Description:
+**  Writes the in-memory dump data for cfg->synthArch over the DDR payload, once the payload and
+**  the sections table are written, and the device specific info that points raw2dump to it.
+**  32 bit structures are placed below 4 GB, the runs of X86 and ARM too.
+**
+** Arguments:
+**  oFile - output file or partition
+**  cfg - dump file configuration data
+**
+** Return:
+**  HRESULT
+**
+*****************************************************************************************************/
+HRESULT SynthesizeDump(_Inout_ DEVICE_IO *oFile, _In_ PDUMP_CONFIG cfg)
+{
+    HRESULT             hr = S_OK;
+    SYNTH_STATE         st;
+    KDDEBUGGER_DATA64   decoded = { 0 };
+    BOOL                is64 = FALSE;
+    BOOL                hasApReg = FALSE;
+    UINT32              maxRuns = 0;
+    ULONGLONG           runLimitPA = 0;
+
+    if ((nullptr == oFile) || (nullptr == cfg) || (SYNTH_ARCH_NONE == cfg->synthArch))
+    {
+        printf("ERROR: Invalid arguments passed to SynthesizeDump()\r\n");
+        hr = E_INVALIDARG;
+    }
+    else
+    {
+        is64 = (SYNTH_ARCH_ARM64 == cfg->synthArch);
+        hasApReg = (SYNTH_ARCH_ARM == cfg->synthArch) || (SYNTH_ARCH_ARM64 == cfg->synthArch);
+        maxRuns = (UINT32)(is64 ? SYNTH_MAX_RUNS64 : SYNTH_MAX_RUNS32);
+        runLimitPA = ((SYNTH_ARCH_X86 == cfg->synthArch) || (SYNTH_ARCH_ARM == cfg->synthArch)) ? SYNTH_MAX_PA32 : MAX_ULONGLONG;
+
+        st.random = cfg->seed;
+        st.runPages = 0;
+        st.paLimit = is64 ? MAX_ULONGLONG : SYNTH_MAX_PA32;
+        st.instanceID = 0;
+        st.headerPA = 0;
+        st.directoryTableBase = 0;
+        st.kernelVA = is64 ? SYNTH_KERNEL_VA64 : SYNTH_KERNEL_VA32;
+        st.kdbgWindowIndex = 0;
+        st.kdbgVA = 0;
+        st.kdbgPagePA = 0;
+        st.waitNever = 0;
+        st.waitAlways = 0;
+        st.salt = 0;
+        st.apRegPA = 0;
+    }
+
+    if (FAILED(hr))
+    { // Invalid arguments, already reported
+    }
+    else if (FAILED(hr = SynthCarveRuns(cfg, &st, maxRuns, runLimitPA)))
+    {
+        printf("ERROR: cannot carve the physical memory runs, (%#lx)\r\n", hr);
+    }
+    else if (FAILED(hr = SynthAllocPages(&st, SYNTH_HEADER_PAGES, &st.headerPA)))
+    {
+        printf("ERROR: no room for the DUMP_HEADER, (%#lx)\r\n", hr);
+    }
+    else if (FAILED(hr = SynthAllocPages(&st, 1, &st.kdbgPagePA)))
+    {
+        printf("ERROR: no room for the KdDebuggerDataBlock, (%#lx)\r\n", hr);
+    }
+    else
+    {
+        st.instanceID = SynthRandom(&st) | 1;
+        st.kdbgWindowIndex = (UINT32)(SynthRandom(&st) % SYNTH_KERNEL_PAGES);
+        st.kdbgVA = st.kernelVA + ((ULONGLONG)st.kdbgWindowIndex << SYNTH_PAGE_SHIFT);
+
+        if (FAILED(hr = SynthWritePageTables(oFile, cfg, &st)))
+        {
+            printf("ERROR: failed to write the page tables, (%#lx)\r\n", hr);
+        }
+        else if (FAILED(hr = SynthWriteKdbg(oFile, cfg, &st, &decoded)))
+        {
+            printf("ERROR: failed to write the KdDebuggerDataBlock, (%#lx)\r\n", hr);
+        }
+        else if (FAILED(hr = SynthWriteHeader(oFile, cfg, &st, &decoded)))
+        {
+            printf("ERROR: failed to write the DUMP_HEADER, (%#lx)\r\n", hr);
+        }
+        else if (hasApReg && !cfg->excludeApReg && FAILED(hr = SynthWriteApReg(oFile, cfg, &st)))
+        {
+            printf("ERROR: failed to write AP_REG, (%#lx)\r\n", hr);
+        }
+        else if (FAILED(hr = SynthWriteDeviceSpecificInfo(oFile, cfg, &st)))
+        {
+            printf("ERROR: failed to write the device specific info, (%#lx)\r\n", hr);
+        }
+        else
+        {
+            printf("INFO: Synthesized %s in-memory dump data, seed %I64u\r\n",
+                   (SYNTH_ARCH_X86 == cfg->synthArch) ? "X86" :
+                   (SYNTH_ARCH_X86PAE == cfg->synthArch) ? "X86 PAE" :
+                   (SYNTH_ARCH_ARM == cfg->synthArch) ? "ARM" : "ARM64",
+                   cfg->seed);
+            printf("INFO:   DUMP_HEADER PA %#I64x, instance %#I64x, %u runs of %I64u pages\r\n",
+                   st.headerPA + sizeof(InMemoryDumpHeaderMagicString), st.instanceID, (UINT32)st.runs.size(), st.runPages);
+            printf("INFO:   DirectoryTableBase %#I64x, KdDebuggerDataBlock VA %#I64x PA %#I64x\r\n",
+                   st.directoryTableBase, st.kdbgVA, st.kdbgPagePA);
+            if (cfg->synthEncodeKdbg)
+            {
+                printf("INFO:   KdDebuggerDataBlock encoded, KiWaitNever %#I64x, KiWaitAlways %#I64x, salt %#x\r\n",
+                       st.waitNever, st.waitAlways, st.salt);
+            }
+
+            if (0 != st.apRegPA)
+            {
+                printf("INFO:   AP_REG PA %#I64x\r\n", st.apRegPA);
+            }
+
+        }
+
+    }
+
+    return hr;
+}
@@ -0,0 +1,70 @@
+/*++
+
+Copyright (C) Microsoft. All rights reserved.
+
+Module Name:
+    synthDump.h
+
+Abstract:
+    Synthesizes the in-memory dump data the kernel leaves in DDR for raw2dump:
+    the magic string and DUMP_HEADER with its physical memory runs, the page
+    tables of a kernel window, the KdDebuggerDataBlock (optionally encoded),
+    the AP_REG tables and the device specific info at the end of the output.
+    The data is written over the DDR payload, so that raw dumps of any size
+    and fragmentation can be converted end to end.  Every choice comes from
+    the /Seed value, the same switches and seed give the same dump.
+
+Environment:
+    User Mode
+
+--*/
+
+#pragma once
+
+#include "makeDumpFile.h"
+
+#define SYNTH_PAGE_SIZE                     0x1000
+#define SYNTH_PAGE_SHIFT                    12
+#define SYNTH_MAX_PA32                      0x100000000ULL          // 32 bit page table entries hold 32 bit physical addresses
+#define SYNTH_KERNEL_VA32                   0x80000000ULL
+#define SYNTH_KERNEL_VA64                   0xFFFFF80000000000ULL
+#define SYNTH_KERNEL_PAGES                  512                     // pages mapped by the last level table of the kernel window
+#define SYNTH_HEADER_PAGES                  3                       // magic string, DUMP_HEADER, decoded KdDebuggerDataBlock and its PA
+#define SYNTH_MIN_RUN_PAGES                 16                      // smallest slot a DDR section is split in
+#define SYNTH_ALLOC_TRIES                   64                      // random placements tried before a linear search
+#define SYNTH_MAX_TABLE_LEVELS              4
+
+// Layout of the page holding the KdDebuggerDataBlock
+#define SYNTH_BUGCHECK_DATA_OFFSET          0x800                   // KiBugcheckData
+#define SYNTH_ENCODED_FLAG_OFFSET           0x900                   // KdpDataBlockEncoded, its address salts the encoding
+#define SYNTH_WAIT_NEVER_OFFSET             0x908                   // KiWaitNever
+#define SYNTH_WAIT_ALWAYS_OFFSET            0x910                   // KiWaitAlways
+
+typedef struct _SYNTH_RUN
+{ // Physical memory run, or allocated range, in pages
+    ULONGLONG       basePage;
+    ULONGLONG       pageCount;
+} SYNTH_RUN, *PSYNTH_RUN;
+
+typedef struct _SYNTH_STATE
+{ // Everything placed so far, all random choices come from random
+    ULONGLONG               random;                 // splitmix64 state, starts at the seed
+    std::vector<SYNTH_RUN>  runs;                   // PhysicalMemoryBlock runs, ascending
+    ULONGLONG               runPages;               // total pages in runs
+    std::vector<SYNTH_RUN>  allocated;              // pages used by the synthesized structures
+    ULONGLONG               paLimit;                // structures end below this physical address
+
+    ULONGLONG               instanceID;             // DUMP_HEADER.Comment and DEVICE_SPECIFIC_INFO.DumpHeaderInstanceID
+    ULONGLONG               headerPA;               // magic string, the DUMP_HEADER follows it
+    ULONGLONG               directoryTableBase;
+    ULONGLONG               kernelVA;               // first page of the mapped kernel window
+    UINT32                  kdbgWindowIndex;        // window page holding the KdDebuggerDataBlock
+    ULONGLONG               kdbgVA;
+    ULONGLONG               kdbgPagePA;
+    ULONGLONG               waitNever;              // encoding keys, when /EncodeKdbg
+    ULONGLONG               waitAlways;
+    ULONG                   salt;
+    ULONGLONG               apRegPA;
+} SYNTH_STATE, *PSYNTH_STATE;
+
+HRESULT SynthesizeDump(_Inout_ DEVICE_IO *oFile, _In_ PDUMP_CONFIG cfg);